@@ -0,0 +1,514 @@
+#include "s21_decomposition.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace {
+
+constexpr int kBlockSize = 32;
+constexpr int kMaxIterations = 30;
+
+// Turns x into the vector v (v[0] = 1) of the reflector H = I - tau v v^T
+// that maps the original x onto beta * e_1, and returns tau.
+double MakeHouseholder(std::vector<double>& x, double& beta) {
+  double sigma = 0;
+  for (size_t i = 1; i < x.size(); i++) sigma += x[i] * x[i];
+  double alpha = x[0];
+  double tau = 0;
+  beta = alpha;
+  if (sigma != 0) {
+    beta = -std::copysign(sqrt(alpha * alpha + sigma), alpha);
+    tau = (beta - alpha) / beta;
+    double scale = 1 / (alpha - beta);
+    for (size_t i = 1; i < x.size(); i++) x[i] *= scale;
+  }
+  x[0] = 1;
+  return tau;
+}
+
+// z = H_0 * H_1 * ... * H_{r-1} * z, where column j of v holds the vector
+// of H_j. Reflectors are grouped into blocks in compact WY form,
+// H_b ... H_e = I - V T V^T, so each block costs three Gemm calls.
+void ApplyReflectors(const S21Matrix& v, const std::vector<double>& tau,
+                     S21Matrix& z) {
+  int size = v.GetRows();
+  for (int end = static_cast<int>(tau.size()); end > 0; end -= kBlockSize) {
+    int begin = std::max(0, end - kBlockSize);
+    int width = end - begin;
+    S21Matrix block(size, width);
+    for (int i = 0; i < size; i++) {
+      for (int j = 0; j < width; j++) block(i, j) = v.At(i, begin + j);
+    }
+    S21Matrix t(width, width);
+    S21Matrix products(width, width);
+    products.Gemm(1, block, true, block, false, 0);
+    for (int j = 0; j < width; j++) {
+      t(j, j) = tau[begin + j];
+      for (int p = 0; p < j; p++) {
+        double sum = 0;
+        for (int q = p; q < j; q++) sum += t(p, q) * products(q, j);
+        t(p, j) = -tau[begin + j] * sum;
+      }
+    }
+    S21Matrix w(width, z.GetCols());
+    S21Matrix tw(width, z.GetCols());
+    w.Gemm(1, block, true, z, false, 0);
+    tw.Gemm(1, t, false, w, false, 0);
+    z.Gemm(-1, block, false, tw, false, 1);
+  }
+}
+
+// Row-major size x size identity.
+std::vector<double> Identity(const int size) {
+  std::vector<double> result(static_cast<size_t>(size) * size, 0);
+  for (int i = 0; i < size; i++) result[i * size + i] = 1;
+  return result;
+}
+
+// The first size rows of a rows x size matrix whose columns are stored one
+// after another in columns; the remaining rows are zero.
+S21Matrix FromColumns(const std::vector<double>& columns, const int size,
+                      const int rows) {
+  S21Matrix result(rows, size);
+  for (int j = 0; j < size; j++) {
+    for (int i = 0; i < size; i++) result(i, j) = columns[j * size + i];
+  }
+  return result;
+}
+
+// Rows begin .. end - 1 of a row-major panel with width columns.
+S21Matrix PanelRows(const std::vector<double>& panel, const int width,
+                    const int begin, const int end) {
+  S21Matrix result(end - begin, width);
+  for (int i = begin; i < end; i++) {
+    for (int j = 0; j < width; j++) result(i - begin, j) = panel[i * width + j];
+  }
+  return result;
+}
+
+// a[begin:, begin:] -= P Q^T + R S^T on the row-major rows x cols array a.
+// The panels have width columns and are indexed by global row: P and R by
+// rows of a, Q and S by columns of a.
+void UpdateTrailing(std::vector<double>& a, const int rows, const int cols,
+                    const int begin, const int width,
+                    const std::vector<double>& p, const std::vector<double>& q,
+                    const std::vector<double>& r,
+                    const std::vector<double>& s) {
+  if (begin >= rows || begin >= cols) return;
+  S21Matrix update(rows - begin, cols - begin);
+  update.Gemm(1, PanelRows(p, width, begin, rows), false,
+              PanelRows(q, width, begin, cols), true, 0);
+  update.Gemm(1, PanelRows(r, width, begin, rows), false,
+              PanelRows(s, width, begin, cols), true, 1);
+  for (int i = begin; i < rows; i++) {
+    double* row = &a[i * cols];
+    for (int j = begin; j < cols; j++) {
+      row[j] -= update.At(i - begin, j - begin);
+    }
+  }
+}
+
+// Implicit QL iteration on the symmetric tridiagonal matrix with diagonal d
+// and subdiagonal e (e[i] couples i and i + 1); the rotations are
+// accumulated into z, whose columns are stored one after another so that
+// every rotation runs over two contiguous arrays.
+void DiagonalizeTridiagonal(std::vector<double>& d, std::vector<double>& e,
+                            std::vector<double>& z) {
+  int n = static_cast<int>(d.size());
+  double eps = std::numeric_limits<double>::epsilon();
+  for (int l = 0; l < n; l++) {
+    int iterations = 0;
+    int m = l;
+    do {
+      for (m = l; m < n - 1; m++) {
+        if (fabs(e[m]) <= eps * (fabs(d[m]) + fabs(d[m + 1]))) break;
+      }
+      if (m != l) {
+        if (iterations++ == kMaxIterations) {
+          throw std::logic_error("No convergence");
+        }
+        double g = (d[l + 1] - d[l]) / (2 * e[l]);
+        double r = std::hypot(g, 1.0);
+        g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+        double s = 1, c = 1, p = 0;
+        int i = m - 1;
+        for (; i >= l; i--) {
+          double f = s * e[i], b = c * e[i];
+          e[i + 1] = r = std::hypot(f, g);
+          if (r == 0) {
+            d[i + 1] -= p;
+            e[m] = 0;
+            break;
+          }
+          s = f / r;
+          c = g / r;
+          g = d[i + 1] - p;
+          r = (d[i] - g) * s + 2 * c * b;
+          d[i + 1] = g + (p = s * r);
+          g = c * r - b;
+          double* z_i = &z[i * n];
+          double* z_next = &z[(i + 1) * n];
+          for (int k = 0; k < n; k++) {
+            f = z_next[k];
+            z_next[k] = s * z_i[k] + c * f;
+            z_i[k] = c * z_i[k] - s * f;
+          }
+        }
+        if (r == 0 && i >= l) continue;
+        d[l] -= p;
+        e[l] = g;
+        e[m] = 0;
+      }
+    } while (m != l);
+  }
+}
+
+// Golub-Kahan QR iteration on the upper bidiagonal matrix with diagonal w
+// and superdiagonal rv1 (rv1[i] couples i - 1 and i). Left rotations are
+// accumulated into u and right rotations into v, both stored column after
+// column as in DiagonalizeTridiagonal.
+void DiagonalizeBidiagonal(std::vector<double>& w, std::vector<double>& rv1,
+                           std::vector<double>& u, std::vector<double>& v) {
+  int n = static_cast<int>(w.size());
+  double eps = std::numeric_limits<double>::epsilon();
+  double norm = 0;
+  for (int i = 0; i < n; i++) norm = std::max(norm, fabs(w[i]) + fabs(rv1[i]));
+  for (int k = n - 1; k >= 0; k--) {
+    for (int iterations = 0;; iterations++) {
+      bool cancel = true;
+      int l = k;
+      for (; l >= 0; l--) {
+        if (l == 0 || fabs(rv1[l]) <= eps * norm) {
+          cancel = false;
+          break;
+        }
+        if (fabs(w[l - 1]) <= eps * norm) break;
+      }
+      if (cancel) {
+        // w[l - 1] is negligible: chase rv1[l] out of the matrix.
+        double c = 0, s = 1;
+        for (int i = l; i <= k; i++) {
+          double f = s * rv1[i];
+          rv1[i] = c * rv1[i];
+          if (fabs(f) <= eps * norm) break;
+          double g = w[i];
+          double h = std::hypot(f, g);
+          w[i] = h;
+          c = g / h;
+          s = -f / h;
+          double* u_l = &u[(l - 1) * n];
+          double* u_i = &u[i * n];
+          for (int j = 0; j < n; j++) {
+            double y = u_l[j], z = u_i[j];
+            u_l[j] = y * c + z * s;
+            u_i[j] = z * c - y * s;
+          }
+        }
+      }
+      double z = w[k];
+      if (l == k) {
+        if (z < 0) {
+          w[k] = -z;
+          for (int j = 0; j < n; j++) v[k * n + j] = -v[k * n + j];
+        }
+        break;
+      }
+      if (iterations == kMaxIterations) {
+        throw std::logic_error("No convergence");
+      }
+      double x = w[l], y = w[k - 1], g = rv1[k - 1], h = rv1[k];
+      double f = ((y - z) * (y + z) + (g - h) * (g + h)) / (2 * h * y);
+      g = std::hypot(f, 1.0);
+      f = ((x - z) * (x + z) + h * ((y / (f + std::copysign(g, f))) - h)) / x;
+      double c = 1, s = 1;
+      for (int j = l; j < k; j++) {
+        int i = j + 1;
+        g = rv1[i];
+        y = w[i];
+        h = s * g;
+        g = c * g;
+        z = std::hypot(f, h);
+        rv1[j] = z;
+        c = f / z;
+        s = h / z;
+        f = x * c + g * s;
+        g = g * c - x * s;
+        h = y * s;
+        y *= c;
+        double* v_j = &v[j * n];
+        double* v_i = &v[i * n];
+        for (int jj = 0; jj < n; jj++) {
+          x = v_j[jj];
+          z = v_i[jj];
+          v_j[jj] = x * c + z * s;
+          v_i[jj] = z * c - x * s;
+        }
+        z = std::hypot(f, h);
+        w[j] = z;
+        if (z != 0) {
+          c = f / z;
+          s = h / z;
+        }
+        f = c * g + s * y;
+        x = c * y - s * g;
+        double* u_j = &u[j * n];
+        double* u_i = &u[i * n];
+        for (int jj = 0; jj < n; jj++) {
+          y = u_j[jj];
+          z = u_i[jj];
+          u_j[jj] = y * c + z * s;
+          u_i[jj] = z * c - y * s;
+        }
+      }
+      rv1[l] = 0;
+      rv1[k] = f;
+      w[k] = x;
+    }
+  }
+}
+
+// Returns the column order that sorts values ascending or descending.
+std::vector<int> SortedOrder(const std::vector<double>& values,
+                             const bool descending) {
+  std::vector<int> order(values.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](int lhs, int rhs) {
+    return descending ? values[lhs] > values[rhs] : values[lhs] < values[rhs];
+  });
+  return order;
+}
+
+S21Matrix PermuteColumns(const S21Matrix& matrix,
+                         const std::vector<int>& order) {
+  S21Matrix result(matrix.GetRows(), static_cast<int>(order.size()));
+  for (int i = 0; i < matrix.GetRows(); i++) {
+    for (size_t j = 0; j < order.size(); j++) {
+      result(i, static_cast<int>(j)) = matrix.At(i, order[j]);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+S21SymmetricEigen::S21SymmetricEigen(const S21Matrix& matrix) {
+  int n = matrix.GetRows();
+  if (n < 1 || n != matrix.GetCols()) {
+    throw std::logic_error("Incorrect size of matrix");
+  }
+  std::vector<double> a(static_cast<size_t>(n) * n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      if (fabs(matrix.At(i, j) - matrix.At(j, i)) > EPS) {
+        throw std::logic_error("Matrix is not symmetric");
+      }
+      a[i * n + j] = (matrix.At(i, j) + matrix.At(j, i)) / 2;
+    }
+  }
+  std::vector<double> d(n), e(n, 0), tau;
+  S21Matrix reflectors(n, std::max(1, n - 2));
+  int steps = std::max(0, n - 2);
+  for (int begin = 0; begin < steps; begin += kBlockSize) {
+    int width = std::min(kBlockSize, steps - begin);
+    // Panel reduction: the current matrix is A - V W^T - W V^T, with the
+    // reflectors of the panel in v and the matching w vectors alongside.
+    // Only the column about to be reduced is brought up to date; the
+    // trailing matrix gets one rank-2k update per panel through Gemm.
+    std::vector<double> v(static_cast<size_t>(n) * width, 0);
+    std::vector<double> w(static_cast<size_t>(n) * width, 0);
+    for (int jj = 0; jj < width; jj++) {
+      int k = begin + jj;
+      for (int i = k; i < n; i++) {
+        for (int p = 0; p < jj; p++) {
+          a[i * n + k] -= v[i * width + p] * w[k * width + p] +
+                          w[i * width + p] * v[k * width + p];
+        }
+      }
+      int len = n - k - 1;
+      std::vector<double> x(len);
+      for (int i = 0; i < len; i++) x[i] = a[(k + 1 + i) * n + k];
+      double t = MakeHouseholder(x, e[k]);
+      // H A H = A - v q^T - q v^T with p = t A v, q = p - (t / 2)(p.v) v.
+      std::vector<double> v_x(jj, 0), w_x(jj, 0);
+      for (int i = 0; i < len; i++) {
+        for (int p = 0; p < jj; p++) {
+          v_x[p] += v[(k + 1 + i) * width + p] * x[i];
+          w_x[p] += w[(k + 1 + i) * width + p] * x[i];
+        }
+      }
+      std::vector<double> q(len);
+      double dot = 0;
+      for (int i = 0; i < len; i++) {
+        const double* row = &a[(k + 1 + i) * n + k + 1];
+        double sum = 0;
+        for (int j = 0; j < len; j++) sum += row[j] * x[j];
+        for (int p = 0; p < jj; p++) {
+          sum -= v[(k + 1 + i) * width + p] * w_x[p] +
+                 w[(k + 1 + i) * width + p] * v_x[p];
+        }
+        q[i] = t * sum;
+        dot += q[i] * x[i];
+      }
+      for (int i = 0; i < len; i++) {
+        v[(k + 1 + i) * width + jj] = x[i];
+        w[(k + 1 + i) * width + jj] = q[i] - t * dot / 2 * x[i];
+        reflectors(k + 1 + i, k) = x[i];
+      }
+      tau.push_back(t);
+    }
+    UpdateTrailing(a, n, n, begin + width, width, v, w, w, v);
+  }
+  for (int k = 0; k < n; k++) d[k] = a[k * n + k];
+  if (n > 1) e[n - 2] = a[(n - 1) * n + n - 2];
+
+  std::vector<double> columns = Identity(n);
+  DiagonalizeTridiagonal(d, e, columns);
+  S21Matrix z = FromColumns(columns, n, n);
+  ApplyReflectors(reflectors, tau, z);
+
+  std::vector<int> order = SortedOrder(d, false);
+  eigenvalues_ = S21Matrix(n, 1);
+  for (int i = 0; i < n; i++) eigenvalues_(i, 0) = d[order[i]];
+  eigenvectors_ = PermuteColumns(z, order);
+}
+
+const S21Matrix& S21SymmetricEigen::GetEigenvalues() const {
+  return eigenvalues_;
+}
+
+const S21Matrix& S21SymmetricEigen::GetEigenvectors() const {
+  return eigenvectors_;
+}
+
+S21SVD::S21SVD(const S21Matrix& matrix) {
+  if (matrix.GetRows() < 1 || matrix.GetCols() < 1) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  // Work on the tall orientation and swap U and V back at the end.
+  bool wide = matrix.GetRows() < matrix.GetCols();
+  S21Matrix a = wide ? matrix.Transpose() : matrix;
+  int m = a.GetRows(), n = a.GetCols();
+  std::vector<double> work(static_cast<size_t>(m) * n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) work[i * n + j] = a.At(i, j);
+  }
+  std::vector<double> w(n), rv1(n, 0), tau_left, tau_right;
+  S21Matrix left(m, n), right(n, std::max(1, n - 1));
+  for (int begin = 0; begin < n; begin += kBlockSize) {
+    int width = std::min(kBlockSize, n - begin);
+    // Panel reduction: the current matrix is A - U Y^T - X V^T, with the
+    // left reflectors in u, the right ones in v and the matching y and x
+    // vectors alongside. Only row and column k are brought up to date as
+    // they are reduced; the trailing matrix is updated once per panel.
+    std::vector<double> u(static_cast<size_t>(m) * width, 0);
+    std::vector<double> x(static_cast<size_t>(m) * width, 0);
+    std::vector<double> y(static_cast<size_t>(n) * width, 0);
+    std::vector<double> v(static_cast<size_t>(n) * width, 0);
+    for (int jj = 0; jj < width; jj++) {
+      int k = begin + jj;
+      std::vector<double> h(m - k);
+      for (int i = k; i < m; i++) {
+        double sum = work[i * n + k];
+        for (int p = 0; p < jj; p++) {
+          sum -= u[i * width + p] * y[k * width + p] +
+                 x[i * width + p] * v[k * width + p];
+        }
+        h[i - k] = sum;
+      }
+      double t = MakeHouseholder(h, w[k]);
+      for (int i = k; i < m; i++) {
+        u[i * width + jj] = h[i - k];
+        left(i, k) = h[i - k];
+      }
+      tau_left.push_back(t);
+      // y = t (A - U Y^T - X V^T)^T u over columns k + 1 .. n - 1.
+      std::vector<double> u_h(jj, 0), x_h(jj, 0), a_h(n, 0);
+      for (int i = k; i < m; i++) {
+        const double* row = &work[i * n];
+        for (int j = k + 1; j < n; j++) a_h[j] += row[j] * h[i - k];
+        for (int p = 0; p < jj; p++) {
+          u_h[p] += u[i * width + p] * h[i - k];
+          x_h[p] += x[i * width + p] * h[i - k];
+        }
+      }
+      for (int j = k + 1; j < n; j++) {
+        double sum = a_h[j];
+        for (int p = 0; p < jj; p++) {
+          sum -= y[j * width + p] * u_h[p] + v[j * width + p] * x_h[p];
+        }
+        y[j * width + jj] = t * sum;
+      }
+      if (k + 1 == n) continue;
+      std::vector<double> g(n - k - 1);
+      for (int j = k + 1; j < n; j++) {
+        double sum = work[k * n + j];
+        for (int p = 0; p <= jj; p++) {
+          sum -= u[k * width + p] * y[j * width + p];
+        }
+        for (int p = 0; p < jj; p++) sum -= x[k * width + p] * v[j * width + p];
+        g[j - k - 1] = sum;
+      }
+      t = MakeHouseholder(g, rv1[k + 1]);
+      for (int j = k + 1; j < n; j++) {
+        v[j * width + jj] = g[j - k - 1];
+        right(j, k) = g[j - k - 1];
+      }
+      tau_right.push_back(t);
+      // x = t (A - U Y^T - X V^T) v over rows k + 1 .. m - 1.
+      std::vector<double> y_g(jj + 1, 0), v_g(jj, 0);
+      for (int j = k + 1; j < n; j++) {
+        for (int p = 0; p <= jj; p++) y_g[p] += y[j * width + p] * g[j - k - 1];
+        for (int p = 0; p < jj; p++) v_g[p] += v[j * width + p] * g[j - k - 1];
+      }
+      for (int i = k + 1; i < m; i++) {
+        const double* row = &work[i * n + k + 1];
+        double sum = 0;
+        for (int j = 0; j < n - k - 1; j++) sum += row[j] * g[j];
+        for (int p = 0; p <= jj; p++) sum -= u[i * width + p] * y_g[p];
+        for (int p = 0; p < jj; p++) sum -= x[i * width + p] * v_g[p];
+        x[i * width + jj] = t * sum;
+      }
+    }
+    UpdateTrailing(work, m, n, begin + width, width, u, y, x, v);
+  }
+
+  std::vector<double> u_columns = Identity(n);
+  std::vector<double> v_columns = Identity(n);
+  DiagonalizeBidiagonal(w, rv1, u_columns, v_columns);
+  S21Matrix u = FromColumns(u_columns, n, m);
+  S21Matrix v = FromColumns(v_columns, n, n);
+  ApplyReflectors(left, tau_left, u);
+  ApplyReflectors(right, tau_right, v);
+
+  std::vector<int> order = SortedOrder(w, true);
+  singular_values_ = S21Matrix(n, 1);
+  for (int i = 0; i < n; i++) singular_values_(i, 0) = w[order[i]];
+  u_ = PermuteColumns(wide ? v : u, order);
+  v_ = PermuteColumns(wide ? u : v, order);
+}
+
+const S21Matrix& S21SVD::GetU() const { return u_; }
+
+const S21Matrix& S21SVD::GetSingularValues() const { return singular_values_; }
+
+const S21Matrix& S21SVD::GetV() const { return v_; }
+
+int S21SVD::Rank(const double tolerance) const {
+  double limit = tolerance;
+  if (limit < 0) {
+    limit = std::max(u_.GetRows(), v_.GetRows()) * singular_values_.At(0, 0) *
+            std::numeric_limits<double>::epsilon();
+  }
+  int rank = 0;
+  for (int i = 0; i < singular_values_.GetRows(); i++) {
+    if (singular_values_.At(i, 0) > limit) rank++;
+  }
+  return rank;
+}
+
+double S21SVD::ConditionNumber() const {
+  double smallest = singular_values_.At(singular_values_.GetRows() - 1, 0);
+  return (smallest == 0) ? INFINITY : singular_values_.At(0, 0) / smallest;
+}
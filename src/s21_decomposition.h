@@ -0,0 +1,48 @@
+#ifndef SRC_S21_DECOMPOSITION_H_
+#define SRC_S21_DECOMPOSITION_H_
+
+#include "s21_matrix_oop.h"
+
+// Eigen-decomposition A = Z diag(w) Z^T of a symmetric matrix. Householder
+// reduction to tridiagonal form is followed by implicit QL iteration; the
+// reflectors are applied back to the eigenvectors in blocks through Gemm.
+class S21SymmetricEigen {
+ public:
+  explicit S21SymmetricEigen(const S21Matrix& matrix);
+
+  // Column vector of eigenvalues in ascending order.
+  const S21Matrix& GetEigenvalues() const;
+  // Orthonormal eigenvectors stored as columns, in the same order.
+  const S21Matrix& GetEigenvectors() const;
+
+ private:
+  S21Matrix eigenvalues_;
+  S21Matrix eigenvectors_;
+};
+
+// Thin singular value decomposition A = U diag(s) V^T of an m x n matrix,
+// with k = min(m, n) columns in U and V. Householder bidiagonalization is
+// followed by Golub-Kahan QR iteration; the reflectors are applied back to
+// the singular vectors in blocks through Gemm.
+class S21SVD {
+ public:
+  explicit S21SVD(const S21Matrix& matrix);
+
+  const S21Matrix& GetU() const;
+  // Column vector of singular values in descending order.
+  const S21Matrix& GetSingularValues() const;
+  const S21Matrix& GetV() const;
+
+  // Number of singular values above tolerance; a negative tolerance selects
+  // max(m, n) * s_max * machine epsilon.
+  int Rank(const double tolerance = -1) const;
+  // s_max / s_min, or infinity for a rank-deficient matrix.
+  double ConditionNumber() const;
+
+ private:
+  S21Matrix u_;
+  S21Matrix singular_values_;
+  S21Matrix v_;
+};
+
+#endif  // SRC_S21_DECOMPOSITION_H_
@@ -0,0 +1,113 @@
+#include "s21_inverse_updater.h"
+
+#include "s21_lu.h"
+
+S21InverseUpdater::S21InverseUpdater(const S21Matrix& matrix,
+                                     int refactor_period)
+    : matrix_(matrix),
+      determinant_(0),
+      refactor_period_(refactor_period),
+      updates_(0) {
+  if (refactor_period < 1) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  Refactorize();
+}
+
+const S21Matrix& S21InverseUpdater::GetMatrix() const { return matrix_; }
+
+const S21Matrix& S21InverseUpdater::GetInverse() const { return inverse_; }
+
+double S21InverseUpdater::GetDeterminant() const { return determinant_; }
+
+int S21InverseUpdater::GetUpdatesSinceRefactor() const { return updates_; }
+
+void S21InverseUpdater::RankOneUpdate(const S21Matrix& u, const S21Matrix& v) {
+  std::vector<double> u_vec = ToVector_(u);
+  std::vector<double> v_vec = ToVector_(v);
+  int size = matrix_.GetRows();
+  std::vector<double> inv_u(size, 0);
+  for (int i = 0; i < size; i++) {
+    for (int k = 0; k < size; k++) inv_u[i] += inverse_(i, k) * u_vec[k];
+  }
+  ApplyUpdate_(u_vec, v_vec, inv_u);
+}
+
+void S21InverseUpdater::ReplaceRow(const int row, const S21Matrix& values) {
+  int size = matrix_.GetRows();
+  if (row < 0 || row >= size) {
+    throw std::out_of_range("Incorrect index");
+  }
+  std::vector<double> v_vec = ToVector_(values);
+  std::vector<double> u_vec(size, 0);
+  std::vector<double> inv_u(size);
+  u_vec[row] = 1;
+  for (int i = 0; i < size; i++) {
+    v_vec[i] -= matrix_(row, i);
+    inv_u[i] = inverse_(i, row);
+  }
+  ApplyUpdate_(u_vec, v_vec, inv_u);
+}
+
+void S21InverseUpdater::Refactorize() {
+  S21LU<double> lu(matrix_);
+  if (lu.IsSingular()) {
+    throw std::logic_error("Determinant = 0");
+  }
+  inverse_ = lu.Inverse();
+  determinant_ = lu.Determinant();
+  updates_ = 0;
+}
+
+void S21InverseUpdater::ApplyUpdate_(const std::vector<double>& u,
+                                     const std::vector<double>& v,
+                                     const std::vector<double>& inv_u) {
+  int size = matrix_.GetRows();
+  double denom = 1;
+  for (int i = 0; i < size; i++) denom += v[i] * inv_u[i];
+  if (fabs(denom) < EPS || updates_ + 1 >= refactor_period_) {
+    // A vanishing denominator means the update is (nearly) singular, so the
+    // Sherman-Morrison step is unreliable; refactor the updated matrix and
+    // keep the old state if it turns out to be singular.
+    S21Matrix updated(matrix_);
+    for (int i = 0; i < size; i++) {
+      for (int j = 0; j < size; j++) updated(i, j) += u[i] * v[j];
+    }
+    std::swap(matrix_, updated);
+    try {
+      Refactorize();
+    } catch (const std::logic_error&) {
+      std::swap(matrix_, updated);
+      throw;
+    }
+  } else {
+    std::vector<double> v_inv(size, 0);
+    for (int k = 0; k < size; k++) {
+      for (int j = 0; j < size; j++) v_inv[j] += v[k] * inverse_(k, j);
+    }
+    for (int i = 0; i < size; i++) {
+      double scale = inv_u[i] / denom;
+      for (int j = 0; j < size; j++) {
+        matrix_(i, j) += u[i] * v[j];
+        inverse_(i, j) -= scale * v_inv[j];
+      }
+    }
+    determinant_ *= denom;
+    updates_++;
+  }
+}
+
+std::vector<double> S21InverseUpdater::ToVector_(
+    const S21Matrix& vector) const {
+  int size = matrix_.GetRows();
+  bool is_column = vector.GetRows() == size && vector.GetCols() == 1;
+  bool is_row = vector.GetRows() == 1 && vector.GetCols() == size;
+  if (!is_column && !is_row) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  std::vector<double> result(size);
+  for (int i = 0; i < size; i++) {
+    result[i] = is_column ? vector.At(i, 0) : vector.At(0, i);
+  }
+  return result;
+}
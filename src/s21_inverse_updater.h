@@ -0,0 +1,41 @@
+#ifndef SRC_S21_INVERSE_UPDATER_H_
+#define SRC_S21_INVERSE_UPDATER_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Keeps the inverse and determinant of a square matrix up to date under
+// rank-1 updates and row replacements in O(n^2) per change
+// (Sherman-Morrison and the matrix determinant lemma). Every
+// refactor_period updates the inverse is recomputed from scratch to bound
+// accumulated rounding error.
+class S21InverseUpdater {
+ public:
+  static constexpr int kDefaultRefactorPeriod = 64;
+
+  explicit S21InverseUpdater(const S21Matrix& matrix,
+                             int refactor_period = kDefaultRefactorPeriod);
+
+  const S21Matrix& GetMatrix() const;
+  const S21Matrix& GetInverse() const;
+  double GetDeterminant() const;
+  int GetUpdatesSinceRefactor() const;
+
+  void RankOneUpdate(const S21Matrix& u, const S21Matrix& v);
+  void ReplaceRow(const int row, const S21Matrix& values);
+  void Refactorize();
+
+ private:
+  S21Matrix matrix_;
+  S21Matrix inverse_;
+  double determinant_;
+  int refactor_period_;
+  int updates_;
+
+  void ApplyUpdate_(const std::vector<double>& u, const std::vector<double>& v,
+                    const std::vector<double>& inv_u);
+  std::vector<double> ToVector_(const S21Matrix& vector) const;
+};
+
+#endif  // SRC_S21_INVERSE_UPDATER_H_
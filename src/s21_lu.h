@@ -0,0 +1,133 @@
+#ifndef SRC_S21_LU_H_
+#define SRC_S21_LU_H_
+
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting, PA = LU, carried out in the
+// precision T and stored row-major in one block. Results are returned as
+// double-precision S21Matrix objects.
+template <typename T>
+class S21LU {
+ public:
+  explicit S21LU(const S21Matrix& matrix);
+
+  int GetSize() const { return size_; }
+  bool IsSingular() const { return singular_; }
+
+  double Determinant() const;
+  S21Matrix Solve(const S21Matrix& b) const;
+  S21Matrix Inverse() const;
+
+ private:
+  int size_;
+  int sign_;
+  bool singular_;
+  std::vector<T> lu_;
+  std::vector<int> pivots_;
+
+  T& At_(const int i, const int j) { return lu_[i * size_ + j]; }
+  T At_(const int i, const int j) const { return lu_[i * size_ + j]; }
+};
+
+template <typename T>
+S21LU<T>::S21LU(const S21Matrix& matrix)
+    : size_(matrix.GetRows()), sign_(1), singular_(false) {
+  if (matrix.GetRows() < 1 || matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("Incorrect size of matrix");
+  }
+  lu_.resize(static_cast<size_t>(size_) * size_);
+  pivots_.resize(size_);
+  for (int i = 0; i < size_; i++) {
+    pivots_[i] = i;
+    for (int j = 0; j < size_; j++) {
+      At_(i, j) = static_cast<T>(matrix.At(i, j));
+    }
+  }
+  for (int k = 0; k < size_; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < size_; i++) {
+      if (std::abs(At_(i, k)) > std::abs(At_(pivot, k))) pivot = i;
+    }
+    if (At_(pivot, k) == 0) {
+      singular_ = true;
+      continue;
+    }
+    if (pivot != k) {
+      for (int j = 0; j < size_; j++) std::swap(At_(k, j), At_(pivot, j));
+      std::swap(pivots_[k], pivots_[pivot]);
+      sign_ = -sign_;
+    }
+    // Contiguous row update through raw pointers so the compiler can
+    // vectorize it; this O(n^3) loop is where single precision pays off.
+    const T* pivot_row = &lu_[k * size_];
+    for (int i = k + 1; i < size_; i++) {
+      T* row = &lu_[i * size_];
+      T factor = row[k] / pivot_row[k];
+      row[k] = factor;
+      for (int j = k + 1; j < size_; j++) row[j] -= factor * pivot_row[j];
+    }
+  }
+}
+
+template <typename T>
+double S21LU<T>::Determinant() const {
+  double det = sign_;
+  for (int i = 0; i < size_; i++) det *= At_(i, i);
+  return singular_ ? 0 : det;
+}
+
+template <typename T>
+S21Matrix S21LU<T>::Solve(const S21Matrix& b) const {
+  if (b.GetRows() != size_) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  if (singular_) {
+    throw std::logic_error("Determinant = 0");
+  }
+  // The right-hand sides are substituted together, row by row, so every
+  // inner loop is a contiguous axpy over the columns of b. With a single
+  // right-hand side those loops have length one and the solve runs at scalar
+  // speed in either precision.
+  int cols = b.GetCols();
+  std::vector<T> work(static_cast<size_t>(size_) * cols);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < cols; j++) {
+      work[i * cols + j] = static_cast<T>(b.At(pivots_[i], j));
+    }
+  }
+  for (int i = 0; i < size_; i++) {
+    T* row = &work[i * cols];
+    for (int k = 0; k < i; k++) {
+      T factor = At_(i, k);
+      const T* source = &work[k * cols];
+      for (int j = 0; j < cols; j++) row[j] -= factor * source[j];
+    }
+  }
+  for (int i = size_ - 1; i >= 0; i--) {
+    T* row = &work[i * cols];
+    for (int k = i + 1; k < size_; k++) {
+      T factor = At_(i, k);
+      const T* source = &work[k * cols];
+      for (int j = 0; j < cols; j++) row[j] -= factor * source[j];
+    }
+    T pivot = At_(i, i);
+    for (int j = 0; j < cols; j++) row[j] /= pivot;
+  }
+  S21Matrix x(size_, cols);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < cols; j++) x(i, j) = work[i * cols + j];
+  }
+  return x;
+}
+
+template <typename T>
+S21Matrix S21LU<T>::Inverse() const {
+  S21Matrix identity(size_, size_);
+  for (int i = 0; i < size_; i++) identity(i, i) = 1;
+  return Solve(identity);
+}
+
+#endif  // SRC_S21_LU_H_
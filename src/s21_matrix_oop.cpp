@@ -1,51 +1,92 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "s21_lu.h"
+
+namespace {
+
+constexpr size_t kCacheLineBytes = 64;
+constexpr size_t kHugePageBytes = size_t(2) << 20;
+// Below this size thread start-up costs more than the first touch saves.
+constexpr size_t kParallelTouchBytes = size_t(4) << 20;
+
+}  // namespace
+
+std::atomic<bool> S21Matrix::huge_pages_{false};
+std::atomic<int> S21Matrix::touch_threads_{1};
+std::atomic<uint64_t> S21Matrix::cache_hits_{0};
+std::atomic<uint64_t> S21Matrix::cache_misses_{0};
+
 S21Matrix ::S21Matrix() {
   rows_ = 0;
   cols_ = 0;
   matrix_ = nullptr;
+  refs_ = nullptr;
 }
 
-S21Matrix::S21Matrix(int rows, int cols) {
-  if (rows < 1 || cols < 1) {
-    throw std::invalid_argument("Illegal parameters");
-  }
-  rows_ = rows;
-  cols_ = cols;
-  matrix_ = new double*[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_];
-  }
-  FillMatrixByZero_();
+S21Matrix::S21Matrix(int rows, int cols) : S21Matrix(rows, cols, true) {}
+
+S21Matrix::S21Matrix(const int rows, const int cols, const bool zero_fill) {
+  Allocate_(rows, cols);
+  if (zero_fill) FillMatrixByZero_();
 }
 
-S21Matrix ::S21Matrix(const S21Matrix& other)
-    : S21Matrix(other.rows_, other.cols_) {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) = other(i, j);
-    }
+S21Matrix ::S21Matrix(const S21Matrix& other) : S21Matrix() {
+  std::lock_guard<std::mutex> lock(other.mutex_);
+  if (other.refs_ != nullptr && !other.leaked_.load()) {
+    ShareFrom_(other);
+  } else {
+    // References handed out by other would write into a shared buffer, so
+    // a leaked copy-on-write matrix is copied deeply but stays copy-on-write.
+    CopyFrom_(other);
+    if (other.refs_ != nullptr) refs_ = new std::atomic<int>(1);
   }
+  AdoptCache_(other);
 }
 
 S21Matrix ::S21Matrix(S21Matrix&& other) noexcept {
+  std::lock_guard<std::mutex> lock(other.mutex_);
   this->matrix_ = other.matrix_;
   this->rows_ = other.rows_;
   this->cols_ = other.cols_;
+  this->refs_ = other.refs_;
+  AdoptCache_(other);
+  leaked_.store(other.leaked_.exchange(false));
   other.matrix_ = nullptr;
   other.rows_ = 0;
   other.cols_ = 0;
+  other.refs_ = nullptr;
+  other.Touch_();
 }
 
-S21Matrix::~S21Matrix() {
-  if (IsValidMatrix_()) {
-    for (int i = 0; i < rows_; i++) {
-      delete[] matrix_[i];
-      matrix_[i] = nullptr;
-    }
-    delete[] matrix_;
-    matrix_ = nullptr;
+S21Matrix::~S21Matrix() { Release_(); }
+
+void S21Matrix::SetAllocationPolicy(const bool huge_pages,
+                                    const int threads) {
+  if (threads < 1) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  huge_pages_.store(huge_pages);
+  touch_threads_.store(threads);
+}
+
+std::pair<int, int> S21Matrix::RowBlock(const int rows, const int parts,
+                                        const int index) {
+  if (rows < 0 || parts < 1 || index < 0 || index >= parts) {
+    throw std::invalid_argument("Illegal parameters");
   }
+  int base = rows / parts, extra = rows % parts;
+  int begin = index * base + std::min(index, extra);
+  return {begin, begin + base + (index < extra ? 1 : 0)};
 }
 
 int S21Matrix::GetRows() const { return rows_; }
@@ -64,52 +105,118 @@ void S21Matrix::SetCols(const int cols) {
   }
 }
 
+void S21Matrix::SetCopyOnWrite(const bool enable) {
+  if (enable && refs_ == nullptr) {
+    if (!IsValidMatrix_()) {
+      throw std::logic_error("Incorrect matrix");
+    }
+    refs_ = new std::atomic<int>(1);
+    leaked_.store(false);
+  } else if (!enable && refs_ != nullptr) {
+    Detach_();
+    delete refs_;
+    refs_ = nullptr;
+  }
+}
+
+bool S21Matrix::IsCopyOnWrite() const { return refs_ != nullptr; }
+
+bool S21Matrix::IsShared() const {
+  return refs_ != nullptr && refs_->load() > 1;
+}
+
 void S21Matrix::ResizeMatrix_(const int rows, const int cols) {
   if ((rows <= 0) || (cols <= 0)) {
     throw std::invalid_argument("Incorrect size");
   }
-  S21Matrix tmp(*this);
+  bool cow = IsCopyOnWrite();
   S21Matrix dest(rows, cols);
-  dest.FillMatrixByZero_();
-  for (int i = 0; i < std::min(dest.rows_, tmp.rows_); i++) {
-    for (int j = 0; j < std::min(dest.cols_, tmp.cols_); j++) {
-      dest(i, j) = tmp(i, j);
+  for (int i = 0; i < std::min(dest.rows_, rows_); i++) {
+    for (int j = 0; j < std::min(dest.cols_, cols_); j++) {
+      dest.matrix_[i][j] = matrix_[i][j];
     }
   }
-  *this = dest;
+  *this = std::move(dest);
+  SetCopyOnWrite(cow);
 }
 
 bool S21Matrix::EqMatrix(const S21Matrix& other) const {
-  if (!this->IsValidMatrix_() || !other.IsValidMatrix_()) {
-    throw std::logic_error("Incorrect matrix");
-  }
-  bool result = true;
-  if (!this->IsEqSizeMatrix_(other)) {
-    result = false;
-  } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        if (fabs((*this)(i, j) - other(i, j)) > EPS) {
-          result = false;
-          break;
-        }
+  CheckPair_(other);
+  bool result = EqMatrixExact(other);
+  if (!result && IsEqSizeMatrix_(other)) {
+    // Compare in fixed-size blocks: the inner loop has no early exit so it
+    // vectorizes, and a mismatch still stops the scan after its block.
+    const size_t kBlock = 64;
+    size_t count = static_cast<size_t>(rows_) * cols_;
+    const double* lhs = matrix_[0];
+    const double* rhs = other.matrix_[0];
+    result = true;
+    for (size_t begin = 0; begin < count && result; begin += kBlock) {
+      size_t end = std::min(count, begin + kBlock);
+      bool differs = false;
+      for (size_t k = begin; k < end; k++) {
+        differs |= fabs(lhs[k] - rhs[k]) > EPS;
       }
+      result = !differs;
     }
   }
   return result;
 }
 
-void S21Matrix::SumOrSubMatrix_(const S21Matrix& other, char sign) {
-  if (!this->IsValidMatrix_() || !other.IsValidMatrix_()) {
+bool S21Matrix::EqMatrixExact(const S21Matrix& other) const {
+  CheckPair_(other);
+  bool result = IsEqSizeMatrix_(other);
+  if (result && matrix_ != other.matrix_) {
+    result = memcmp(matrix_[0], other.matrix_[0],
+                    static_cast<size_t>(rows_) * cols_ * sizeof(double)) == 0;
+  }
+  return result;
+}
+
+size_t S21Matrix::Hash() const {
+  if (!IsValidMatrix_()) {
     throw std::logic_error("Incorrect matrix");
   }
+  uint64_t hash = HashWord_(kHashSeed_, (uint64_t(rows_) << 32) | cols_);
+  size_t count = static_cast<size_t>(rows_) * cols_;
+  for (size_t k = 0; k < count; k++) {
+    uint64_t bits;
+    memcpy(&bits, &matrix_[0][k], sizeof(bits));
+    hash = HashWord_(hash, bits);
+  }
+  return static_cast<size_t>(hash);
+}
+
+size_t S21Matrix::HashApprox(const double tolerance) const {
+  if (!IsValidMatrix_()) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  if (!(tolerance > 0)) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  uint64_t hash = HashWord_(kHashSeed_, (uint64_t(rows_) << 32) | cols_);
+  size_t count = static_cast<size_t>(rows_) * cols_;
+  for (size_t k = 0; k < count; k++) {
+    // Adding 0.0 turns -0.0 into +0.0 so both signs land in one bucket.
+    double bucket = floor(matrix_[0][k] / tolerance + 0.5) + 0.0;
+    uint64_t bits;
+    memcpy(&bits, &bucket, sizeof(bits));
+    hash = HashWord_(hash, bits);
+  }
+  return static_cast<size_t>(hash);
+}
+
+void S21Matrix::SumOrSubMatrix_(const S21Matrix& other, char sign) {
+  CheckPair_(other);
   if (!this->IsEqSizeMatrix_(other)) {
     throw std::logic_error("Matrixes are not equals");
   }
   int num = (sign == '-') ? -1 : 1;
+  Detach_();
+  Touch_();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) += num * other(i, j);
+      matrix_[i][j] += num * other.matrix_[i][j];
     }
   }
 }
@@ -126,9 +233,11 @@ void S21Matrix::MulNumber(const double num) {
   if (!IsValidMatrix_()) {
     throw std::logic_error("Incorrect matrix");
   }
+  Detach_();
+  Touch_();
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) *= num;
+      matrix_[i][j] *= num;
     }
   }
 }
@@ -140,25 +249,67 @@ void S21Matrix::MulMatrix(const S21Matrix& other) {
   if (this->cols_ != other.rows_) {
     throw std::logic_error("Incorrect dimension of matrices");
   }
-  S21Matrix tmp(this->rows_, other.cols_);
-  for (int i = 0; i < this->rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      for (int k = 0; k < this->cols_; k++) {
-        tmp(i, j) += (*this)(i, k) * other(k, j);
+  bool cow = IsCopyOnWrite();
+  S21Matrix tmp(this->rows_, other.cols_, false);
+  tmp.Gemm(1, *this, false, other, false, 0);
+  *this = std::move(tmp);
+  SetCopyOnWrite(cow);
+}
+
+void S21Matrix::Gemm(const double alpha, const S21Matrix& a,
+                     const bool trans_a, const S21Matrix& b,
+                     const bool trans_b, const double beta) {
+  if (!IsValidMatrix_() || !a.IsValidMatrix_() || !b.IsValidMatrix_()) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  int m = trans_a ? a.cols_ : a.rows_;
+  int depth = trans_a ? a.rows_ : a.cols_;
+  int n = trans_b ? b.rows_ : b.cols_;
+  if (depth != (trans_b ? b.cols_ : b.rows_) || m != rows_ || n != cols_) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  Detach_();
+  Touch_();
+  if (a.matrix_ == matrix_ || b.matrix_ == matrix_) {
+    bool cow = IsCopyOnWrite();
+    S21Matrix result;
+    result.CopyFrom_(*this);
+    result.Gemm(alpha, a, trans_a, b, trans_b, beta);
+    *this = std::move(result);
+    SetCopyOnWrite(cow);
+  } else {
+    for (int i = 0; i < m; i++) {
+      double* row = matrix_[i];
+      for (int j = 0; j < n; j++) row[j] = (beta == 0) ? 0 : beta * row[j];
+      if (alpha == 0) continue;
+      if (!trans_b) {
+        for (int k = 0; k < depth; k++) {
+          double scale = alpha * (trans_a ? a.matrix_[k][i] : a.matrix_[i][k]);
+          const double* b_row = b.matrix_[k];
+          for (int j = 0; j < n; j++) row[j] += scale * b_row[j];
+        }
+      } else {
+        for (int j = 0; j < n; j++) {
+          const double* b_row = b.matrix_[j];
+          double sum = 0;
+          for (int k = 0; k < depth; k++) {
+            sum += (trans_a ? a.matrix_[k][i] : a.matrix_[i][k]) * b_row[k];
+          }
+          row[j] += alpha * sum;
+        }
       }
     }
   }
-  *this = S21Matrix(std::move(tmp));
 }
 
 S21Matrix S21Matrix::Transpose() const {
   if (!IsValidMatrix_()) {
     throw std::logic_error("Incorrect matrix");
   }
-  S21Matrix result(cols_, rows_);
+  S21Matrix result(cols_, rows_, false);
   for (int i = 0; i < rows_; i++) {
     for (int j = 0; j < cols_; j++) {
-      result(j, i) = (*this)(i, j);
+      result.matrix_[j][i] = matrix_[i][j];
     }
   }
   return result;
@@ -173,13 +324,13 @@ S21Matrix S21Matrix::CalcComplements() const {
 
 void S21Matrix::CreateMinorMatrix_(const S21Matrix& other) {
   if (other.cols_ == 1) {
-    (*this)(0, 0) = other(0, 0);
+    (*this)(0, 0) = other.matrix_[0][0];
   } else {
     S21Matrix tmp;
     for (int i = 0; i < rows_; i++) {
       for (int j = 0; j < cols_; j++) {
         tmp.CreateMatrixForDet_(other, i, j);
-        (*this)(i, j) = tmp.Determinant() * GetSign_(i, j);
+        (*this)(i, j) = tmp.ComputeDeterminant_() * GetSign_(i, j);
       }
     }
   }
@@ -187,14 +338,13 @@ void S21Matrix::CreateMinorMatrix_(const S21Matrix& other) {
 
 void S21Matrix::CreateMatrixForDet_(const S21Matrix& other, const int Is,
                                     const int Js) {
-  this->~S21Matrix();
   *this = S21Matrix(other.rows_ - 1, other.cols_ - 1);
   int row = 0;
   for (int i = 0; i < other.rows_; i++) {
     if (i == Is) continue;
     for (int j = 0, col = 0; j < other.cols_; j++) {
       if (j == Js) continue;
-      (*this)(row, col++) = other(i, j);
+      (*this)(row, col++) = other.matrix_[i][j];
     }
     row++;
   }
@@ -202,20 +352,34 @@ void S21Matrix::CreateMatrixForDet_(const S21Matrix& other, const int Is,
 
 double S21Matrix::Determinant() const {
   CheckMatrixAndSize_();
-  double result = (cols_ > 1) ? GetDet_(cols_) : (*this)(0, 0);
-  return result;
+  std::lock_guard<std::mutex> lock(mutex_);
+  ValidateCache_();
+  CountCacheLookup_(cache_.has_determinant);
+  return CachedDeterminant_();
+}
+
+double S21Matrix::CachedDeterminant_() const {
+  if (!cache_.has_determinant) {
+    cache_.determinant = ComputeDeterminant_();
+    cache_.has_determinant = true;
+  }
+  return cache_.determinant;
+}
+
+double S21Matrix::ComputeDeterminant_() const {
+  return (cols_ > 1) ? GetDet_(cols_) : matrix_[0][0];
 }
 
 double S21Matrix::GetDet_(const int size) const {
   double det = 0;
   if (size == 2) {
-    det += (*this)(0, 0) * (*this)(1, 1) - (*this)(1, 0) * (*this)(0, 1);
+    det += matrix_[0][0] * matrix_[1][1] - matrix_[1][0] * matrix_[0][1];
   } else {
     int i = 0;
     while (i < size) {
       S21Matrix tmp;
       tmp.CreateMatrixForDet_(*this, i, 0);
-      det += (*this)(i, 0) * GetSign_(i, 0) * tmp.GetDet_(size - 1);
+      det += matrix_[i][0] * GetSign_(i, 0) * tmp.GetDet_(size - 1);
       i++;
     }
   }
@@ -224,16 +388,44 @@ double S21Matrix::GetDet_(const int size) const {
 
 S21Matrix S21Matrix::InverseMatrix() const {
   CheckMatrixAndSize_();
-  S21Matrix result = S21Matrix(rows_, cols_);
-  if (rows_ == 1) {
-    result(0, 0) = 1 / (*this)(0, 0);
-  } else if (Determinant() != 0) {
-    result = CalcComplements().Transpose();
-    result.MulNumber(1 / Determinant());
-  } else {
-    throw std::logic_error("Determinant = 0");
+  std::lock_guard<std::mutex> lock(mutex_);
+  ValidateCache_();
+  CountCacheLookup_(cache_.inverse != nullptr);
+  if (cache_.inverse == nullptr) {
+    S21Matrix result = S21Matrix(rows_, cols_);
+    if (rows_ == 1) {
+      result(0, 0) = 1 / matrix_[0][0];
+    } else if (CachedDeterminant_() != 0) {
+      result = CalcComplements().Transpose();
+      result.MulNumber(1 / CachedDeterminant_());
+    } else {
+      throw std::logic_error("Determinant = 0");
+    }
+    cache_.inverse = std::make_shared<const S21Matrix>(std::move(result));
   }
-  return result;
+  return *cache_.inverse;
+}
+
+std::shared_ptr<const S21LU<double>> S21Matrix::Factorization() const {
+  CheckMatrixAndSize_();
+  std::lock_guard<std::mutex> lock(mutex_);
+  ValidateCache_();
+  CountCacheLookup_(cache_.lu != nullptr);
+  if (cache_.lu == nullptr) {
+    cache_.lu = std::make_shared<const S21LU<double>>(*this);
+  }
+  return cache_.lu;
+}
+
+uint64_t S21Matrix::GetGeneration() const { return generation_; }
+
+uint64_t S21Matrix::GetCacheHits() { return cache_hits_.load(); }
+
+uint64_t S21Matrix::GetCacheMisses() { return cache_misses_.load(); }
+
+void S21Matrix::ResetCacheStats() {
+  cache_hits_.store(0);
+  cache_misses_.store(0);
 }
 
 S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
@@ -275,16 +467,48 @@ bool S21Matrix::operator==(const S21Matrix& other) const {
 S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
   if (this != &other) {
     S21Matrix tmp(other);
-    this->~S21Matrix();
-    this->rows_ = tmp.rows_;
-    this->cols_ = tmp.cols_;
-    this->matrix_ = tmp.matrix_;
-    tmp.matrix_ = nullptr;
+    *this = std::move(tmp);
   }
   return *this;
 }
 
+S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
+  if (this != &other) {
+    std::lock_guard<std::mutex> lock(other.mutex_);
+    Release_();
+    Touch_();
+    this->rows_ = other.rows_;
+    this->cols_ = other.cols_;
+    this->matrix_ = other.matrix_;
+    this->refs_ = other.refs_;
+    AdoptCache_(other);
+    leaked_.store(other.leaked_.exchange(false));
+    other.matrix_ = nullptr;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.refs_ = nullptr;
+    other.Touch_();
+  }
+  return *this;
+}
+
+double& S21Matrix::operator()(const int i, const int j) {
+  if ((i < 0 || i >= rows_) || (j < 0 || j >= cols_)) {
+    throw std::out_of_range("Incorrect index");
+  }
+  Leak_();
+  return matrix_[i][j];
+}
+
 double& S21Matrix::operator()(const int i, const int j) const {
+  if ((i < 0 || i >= rows_) || (j < 0 || j >= cols_)) {
+    throw std::out_of_range("Incorrect index");
+  }
+  Leak_();
+  return matrix_[i][j];
+}
+
+double S21Matrix::At(const int i, const int j) const {
   if ((i < 0 || i >= rows_) || (j < 0 || j >= cols_)) {
     throw std::out_of_range("Incorrect index");
   }
@@ -295,6 +519,19 @@ bool S21Matrix::IsEqSizeMatrix_(const S21Matrix& other) const {
   return this->cols_ == other.cols_ && this->rows_ == other.rows_;
 }
 
+void S21Matrix::CheckPair_(const S21Matrix& other) const {
+  if (!this->IsValidMatrix_() || !other.IsValidMatrix_()) {
+    throw std::logic_error("Incorrect matrix");
+  }
+}
+
+uint64_t S21Matrix::HashWord_(const uint64_t hash, const uint64_t word) {
+  // FNV-1a step over a whole 64-bit word followed by a final xor-shift so
+  // low bits depend on the high bits of every element.
+  uint64_t result = (hash ^ word) * 0x100000001b3ULL;
+  return result ^ (result >> 29);
+}
+
 bool S21Matrix::IsValidMatrix_() const { return matrix_ != nullptr; }
 
 bool S21Matrix::IsSquareMatrix_() const { return cols_ == rows_; };
@@ -313,9 +550,168 @@ void S21Matrix::CheckMatrixAndSize_() const {
 }
 
 void S21Matrix::FillMatrixByZero_() {
+  ForEachRowBlock_([this](int begin, int end) {
+    std::fill(matrix_[begin], matrix_[begin] + size_t(end - begin) * cols_,
+              0.0);
+  });
+  Touch_();
+}
+
+void S21Matrix::Allocate_(const int rows, const int cols) {
+  if (rows < 1 || cols < 1) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  size_t bytes = static_cast<size_t>(rows) * cols * sizeof(double);
+  bool huge = huge_pages_.load() && bytes >= kHugePageBytes;
+  size_t alignment = huge ? kHugePageBytes : kCacheLineBytes;
+  bytes = (bytes + alignment - 1) / alignment * alignment;
+  // One contiguous block keeps the whole buffer shareable under one refcount.
+  double* data = static_cast<double*>(std::aligned_alloc(alignment, bytes));
+  if (data == nullptr) {
+    throw std::bad_alloc();
+  }
+#ifdef MADV_HUGEPAGE
+  if (huge) madvise(data, bytes, MADV_HUGEPAGE);
+#endif
+  rows_ = rows;
+  cols_ = cols;
+  refs_ = nullptr;
+  leaked_.store(false);
+  try {
+    matrix_ = new double*[rows_];
+  } catch (...) {
+    std::free(data);
+    throw;
+  }
   for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      (*this)(i, j) = 0;
+    matrix_[i] = data + static_cast<size_t>(i) * cols_;
+  }
+}
+
+void S21Matrix::ForEachRowBlock_(
+    const std::function<void(int, int)>& body) {
+  // Nothing has touched the pages of a fresh buffer yet, so whichever
+  // thread writes a block first decides which NUMA node it lives on.
+  size_t bytes = static_cast<size_t>(rows_) * cols_ * sizeof(double);
+  int threads = std::min(touch_threads_.load(), rows_);
+  if (threads <= 1 || bytes < kParallelTouchBytes) {
+    body(0, rows_);
+  } else {
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    int t = 0;
+    try {
+      for (; t < threads; t++) {
+        std::pair<int, int> block = RowBlock(rows_, threads, t);
+        workers.emplace_back(body, block.first, block.second);
+      }
+    } catch (const std::system_error&) {
+      // The system is out of threads; the blocks that did not get one are
+      // filled by the calling thread below.
+    }
+    for (; t < threads; t++) {
+      std::pair<int, int> block = RowBlock(rows_, threads, t);
+      body(block.first, block.second);
+    }
+    for (std::thread& worker : workers) worker.join();
+  }
+}
+
+void S21Matrix::Release_() {
+  if (refs_ == nullptr || refs_->fetch_sub(1) == 1) {
+    if (IsValidMatrix_()) {
+      std::free(matrix_[0]);
+      delete[] matrix_;
     }
+    delete refs_;
   }
+  matrix_ = nullptr;
+  refs_ = nullptr;
+  leaked_.store(false);
+  rows_ = 0;
+  cols_ = 0;
+}
+
+void S21Matrix::CopyFrom_(const S21Matrix& other) {
+  Allocate_(other.rows_, other.cols_);
+  ForEachRowBlock_([this, &other](int begin, int end) {
+    std::copy(other.matrix_[begin],
+              other.matrix_[begin] + size_t(end - begin) * cols_,
+              matrix_[begin]);
+  });
+}
+
+void S21Matrix::ShareFrom_(const S21Matrix& other) {
+  other.refs_->fetch_add(1);
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  matrix_ = other.matrix_;
+  refs_ = other.refs_;
+}
+
+void S21Matrix::Detach_() const {
+  // Const so that Leak_() can detach too; the contents do not change, so
+  // cached results stay valid.
+  if (refs_ != nullptr && refs_->load() > 1) {
+    S21Matrix shared;
+    shared.CopyFrom_(*this);
+    std::swap(matrix_, shared.matrix_);
+    shared.refs_ = refs_;
+    refs_ = new std::atomic<int>(1);
+  }
+}
+
+void S21Matrix::Leak_() const {
+  // A leaked buffer is never shared again, so only the first reference
+  // takes the lock; copies made from other threads are serialized with the
+  // detach through mutex_.
+  if (!leaked_.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Detach_();
+    leaked_.store(true, std::memory_order_release);
+  }
+}
+
+void S21Matrix::Touch_() { generation_++; }
+
+void S21Matrix::ValidateCache_() const {
+  // Writes through references from operator() bypass the generation, so
+  // once any have been handed out, results are also checked against a
+  // snapshot of the elements they were computed from. Results cached
+  // before the first reference have no snapshot and are dropped.
+  size_t count = size_t(rows_) * cols_;
+  bool leaked = leaked_.load();
+  bool stale = cache_.generation != generation_ ||
+               (leaked && (cache_.snapshot == nullptr ||
+                           cache_.snapshot->size() != count ||
+                           std::memcmp(cache_.snapshot->data(), matrix_[0],
+                                       count * sizeof(double)) != 0));
+  if (stale) {
+    cache_.generation = generation_;
+    cache_.snapshot = nullptr;
+    if (leaked) {
+      cache_.snapshot = std::make_shared<const std::vector<double>>(
+          matrix_[0], matrix_[0] + count);
+    }
+    cache_.has_determinant = false;
+    cache_.inverse = nullptr;
+    cache_.lu = nullptr;
+  }
+}
+
+void S21Matrix::AdoptCache_(const S21Matrix& other) {
+  // The caller holds other.mutex_.
+  if (other.cache_.generation == other.generation_) {
+    other.ValidateCache_();
+    cache_.generation = generation_;
+    cache_.snapshot = other.cache_.snapshot;
+    cache_.has_determinant = other.cache_.has_determinant;
+    cache_.determinant = other.cache_.determinant;
+    cache_.inverse = other.cache_.inverse;
+    cache_.lu = other.cache_.lu;
+  }
+}
+
+void S21Matrix::CountCacheLookup_(const bool hit) {
+  (hit ? cache_hits_ : cache_misses_).fetch_add(1, std::memory_order_relaxed);
 }
@@ -1,11 +1,20 @@
 #ifndef SRC_S21_MATRIX_OOP_H_
 #define SRC_S21_MATRIX_OOP_H_
 
+#include <atomic>
 #include <cmath>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #define EPS 1e-7
 
+template <typename T>
+class S21LU;
+
 class S21Matrix {
  public:
   S21Matrix();
@@ -14,21 +23,64 @@ class S21Matrix {
   S21Matrix(S21Matrix&& other) noexcept;
   ~S21Matrix();
 
+  // Process-wide allocation settings. huge_pages aligns large element
+  // buffers to 2 MiB and advises the kernel to back them with transparent
+  // huge pages (Linux). With threads > 1, large buffers are zero-filled or
+  // copied by that many threads, each first-touching the rows returned by
+  // RowBlock(), so the pages land on the NUMA node of the thread that
+  // owns them. Parallel kernels should split rows with RowBlock() too.
+  static void SetAllocationPolicy(const bool huge_pages, const int threads);
+  static std::pair<int, int> RowBlock(const int rows, const int parts,
+                                      const int index);
+
   int GetRows() const;
   int GetCols() const;
   void SetRows(const int rows);
   void SetCols(const int cols);
 
+  // Copies of a copy-on-write matrix share its buffer until one of them is
+  // modified through an in-place operation or hands out a reference. Once
+  // operator() has returned a reference, the buffer is never shared again
+  // and later copies are deep; enabling copy-on-write assumes that no
+  // reference obtained before it is written through afterwards.
+  void SetCopyOnWrite(const bool enable);
+  bool IsCopyOnWrite() const;
+  bool IsShared() const;
+
   bool EqMatrix(const S21Matrix& other) const;
+  bool EqMatrixExact(const S21Matrix& other) const;
+  // Hash() agrees with EqMatrixExact. HashApprox() rounds every element to
+  // a multiple of tolerance first, so matrices equal within tolerance
+  // usually share a hash; values straddling a rounding boundary do not, so
+  // candidates still have to be confirmed with EqMatrix.
+  size_t Hash() const;
+  size_t HashApprox(const double tolerance = EPS) const;
   void SumMatrix(const S21Matrix& other);
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
   void MulMatrix(const S21Matrix& other);
+  // this = alpha * op(a) * op(b) + beta * this, where op() transposes its
+  // operand when the matching flag is set. No temporaries are allocated
+  // unless a or b is this matrix itself.
+  void Gemm(const double alpha, const S21Matrix& a, const bool trans_a,
+            const S21Matrix& b, const bool trans_b, const double beta);
 
   S21Matrix Transpose() const;
   S21Matrix CalcComplements() const;
   double Determinant() const;
   S21Matrix InverseMatrix() const;
+  std::shared_ptr<const S21LU<double>> Factorization() const;
+
+  // Determinant, InverseMatrix and Factorization are computed once and
+  // reused until the matrix changes. In-place operations, Gemm, resizing
+  // and assignment bump the generation and drop the cache outright. A
+  // matrix that has handed out references through operator() can also be
+  // written through them, so its cached results are kept with a full copy
+  // of the elements, compared on every lookup.
+  uint64_t GetGeneration() const;
+  static uint64_t GetCacheHits();
+  static uint64_t GetCacheMisses();
+  static void ResetCacheStats();
 
   S21Matrix operator+(const S21Matrix& other) const;
   S21Matrix operator-(const S21Matrix& other) const;
@@ -40,21 +92,68 @@ class S21Matrix {
   void operator*=(const double num);
   void operator*=(const S21Matrix& other);
 
+  // Both overloads hand out a writable reference, so on a shared
+  // copy-on-write matrix both detach first and the buffer stops being
+  // shareable. Use At() for reads that must keep it shared.
+  double& operator()(const int i, const int j);
   double& operator()(const int i, const int j) const;
+  double At(const int i, const int j) const;
   S21Matrix& operator=(const S21Matrix& other);
+  S21Matrix& operator=(S21Matrix&& other) noexcept;
   bool operator==(const S21Matrix& other) const;
 
  private:
   int rows_, cols_;
-  double** matrix_;
+  mutable double** matrix_;
+  mutable std::atomic<int>* refs_;
+
+  struct ResultCache_ {
+    uint64_t generation = 0;
+    std::shared_ptr<const std::vector<double>> snapshot;
+    bool has_determinant = false;
+    double determinant = 0;
+    std::shared_ptr<const S21Matrix> inverse;
+    std::shared_ptr<const S21LU<double>> lu;
+  };
+
+  uint64_t generation_ = 1;
+  // Guards the cache and the sharing state (matrix_, refs_, leaked_)
+  // against concurrent copies and const accesses.
+  mutable std::mutex mutex_;
+  // Set once operator() has handed out a reference into the buffer.
+  mutable std::atomic<bool> leaked_{false};
+  mutable ResultCache_ cache_;
+  static std::atomic<bool> huge_pages_;
+  static std::atomic<int> touch_threads_;
+  static std::atomic<uint64_t> cache_hits_;
+  static std::atomic<uint64_t> cache_misses_;
+
+  static constexpr uint64_t kHashSeed_ = 0xcbf29ce484222325ULL;
+  static uint64_t HashWord_(const uint64_t hash, const uint64_t word);
 
   bool IsValidMatrix_() const;
   bool IsSquareMatrix_() const;
   bool IsEqSizeMatrix_(const S21Matrix& other) const;
+  void CheckPair_(const S21Matrix& other) const;
 
+  double ComputeDeterminant_() const;
+  double CachedDeterminant_() const;
   double GetDet_(const int size) const;
   int GetSign_(const int indRow, const int indCol) const;
 
+  S21Matrix(const int rows, const int cols, const bool zero_fill);
+
+  void Allocate_(const int rows, const int cols);
+  void ForEachRowBlock_(const std::function<void(int, int)>& body);
+  void Release_();
+  void CopyFrom_(const S21Matrix& other);
+  void ShareFrom_(const S21Matrix& other);
+  void Detach_() const;
+  void Leak_() const;
+  void Touch_();
+  void ValidateCache_() const;
+  void AdoptCache_(const S21Matrix& other);
+  static void CountCacheLookup_(const bool hit);
   void ResizeMatrix_(const int rows, const int cols);
   void SumOrSubMatrix_(const S21Matrix& other, char sign);
   void FillMatrixByZero_();
@@ -0,0 +1,77 @@
+#include "s21_mixed_solver.h"
+
+S21MixedSolver::S21MixedSolver(const S21Matrix& matrix, int max_iterations,
+                               double tolerance)
+    : matrix_(matrix),
+      lu_(matrix),
+      max_iterations_(max_iterations),
+      tolerance_(tolerance),
+      iterations_(0),
+      residual_(0),
+      fallback_(false),
+      norm_a_(0) {
+  if (max_iterations < 0 || tolerance <= 0) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  for (int i = 0; i < matrix_.GetRows(); i++) {
+    for (int k = 0; k < matrix_.GetCols(); k++) {
+      norm_a_ = fmax(norm_a_, fabs(matrix_.At(i, k)));
+    }
+  }
+}
+
+S21Matrix S21MixedSolver::Solve(const S21Matrix& b) {
+  if (b.GetRows() != matrix_.GetRows()) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  S21Matrix r(b.GetRows(), b.GetCols());
+  S21Matrix x;
+  iterations_ = 0;
+  fallback_ = fallback_lu_ != nullptr || lu_.IsSingular();
+  if (!fallback_) {
+    x = lu_.Solve(b);
+    residual_ = GetResidual_(b, x, r);
+    while (!(residual_ <= tolerance_) && iterations_ < max_iterations_) {
+      double previous = residual_;
+      x += lu_.Solve(r);
+      residual_ = GetResidual_(b, x, r);
+      iterations_++;
+      // Refinement converges linearly; once it stops halving the residual
+      // the single-precision factor is too inaccurate for this system.
+      if (!(residual_ < previous / 2)) break;
+    }
+    fallback_ = !(residual_ <= tolerance_);
+  }
+  if (fallback_) {
+    if (fallback_lu_ == nullptr) {
+      fallback_lu_ = std::make_shared<const S21LU<double>>(matrix_);
+    }
+    x = fallback_lu_->Solve(b);
+    residual_ = GetResidual_(b, x, r);
+  }
+  return x;
+}
+
+int S21MixedSolver::GetIterations() const { return iterations_; }
+
+double S21MixedSolver::GetResidual() const { return residual_; }
+
+bool S21MixedSolver::IsFallback() const { return fallback_; }
+
+double S21MixedSolver::GetResidual_(const S21Matrix& b, const S21Matrix& x,
+                                    S21Matrix& r) const {
+  // Normwise backward error max|b - Ax| / (max|A| * max|x| + max|b|).
+  r = b;
+  r.Gemm(-1, matrix_, false, x, false, 1);
+  double norm_x = 0, norm_b = 0, norm_r = 0;
+  for (int i = 0; i < b.GetRows(); i++) {
+    for (int j = 0; j < b.GetCols(); j++) {
+      if (!std::isfinite(r.At(i, j))) return INFINITY;
+      norm_r = fmax(norm_r, fabs(r.At(i, j)));
+      norm_x = fmax(norm_x, fabs(x.At(i, j)));
+      norm_b = fmax(norm_b, fabs(b.At(i, j)));
+    }
+  }
+  double scale = norm_a_ * norm_x + norm_b;
+  return (scale > 0) ? norm_r / scale : norm_r;
+}
@@ -0,0 +1,48 @@
+#ifndef SRC_S21_MIXED_SOLVER_H_
+#define SRC_S21_MIXED_SOLVER_H_
+
+#include <memory>
+
+#include "s21_lu.h"
+#include "s21_matrix_oop.h"
+
+// Solves A x = b by factoring A once in single precision and refining the
+// solution with double-precision residuals against the original matrix.
+// When refinement stalls or does not reach the tolerance, the system is
+// solved again with a double-precision factorization, which is kept and
+// used directly by every later Solve.
+//
+// Only the O(n^3) factorization runs in single precision. Its row update is
+// a contiguous loop that is vectorized only with -O3 or -ftree-vectorize;
+// without that, and for small systems, plain S21LU<double> is as fast.
+class S21MixedSolver {
+ public:
+  static constexpr int kDefaultMaxIterations = 10;
+  static constexpr double kDefaultTolerance = 1e-12;
+
+  explicit S21MixedSolver(const S21Matrix& matrix,
+                          int max_iterations = kDefaultMaxIterations,
+                          double tolerance = kDefaultTolerance);
+
+  S21Matrix Solve(const S21Matrix& b);
+
+  int GetIterations() const;
+  double GetResidual() const;
+  bool IsFallback() const;
+
+ private:
+  S21Matrix matrix_;
+  S21LU<float> lu_;
+  int max_iterations_;
+  double tolerance_;
+  int iterations_;
+  double residual_;
+  bool fallback_;
+  double norm_a_;
+  std::shared_ptr<const S21LU<double>> fallback_lu_;
+
+  double GetResidual_(const S21Matrix& b, const S21Matrix& x,
+                      S21Matrix& r) const;
+};
+
+#endif  // SRC_S21_MIXED_SOLVER_H_
@@ -0,0 +1,462 @@
+#include "s21_structured_matrix.h"
+
+#include <utility>
+
+#include "s21_lu.h"
+
+S21TriangularMatrix::S21TriangularMatrix() : size_(0), uplo_(kLower) {}
+
+S21TriangularMatrix::S21TriangularMatrix(int size, Uplo uplo)
+    : size_(size), uplo_(uplo) {
+  if (size < 1) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  data_.assign(static_cast<size_t>(size_) * (size_ + 1) / 2, 0);
+}
+
+S21TriangularMatrix::S21TriangularMatrix(const S21Matrix& other, Uplo uplo)
+    : S21TriangularMatrix(other.GetRows(), uplo) {
+  if (other.GetRows() != other.GetCols()) {
+    throw std::logic_error("Incorrect size of matrix");
+  }
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      if (IsStored_(i, j)) data_[Index_(i, j)] = other.At(i, j);
+    }
+  }
+}
+
+int S21TriangularMatrix::GetSize() const { return size_; }
+
+S21TriangularMatrix::Uplo S21TriangularMatrix::GetUplo() const {
+  return uplo_;
+}
+
+double S21TriangularMatrix::At(const int i, const int j) const {
+  CheckIndex_(i, j);
+  return IsStored_(i, j) ? data_[Index_(i, j)] : 0;
+}
+
+double& S21TriangularMatrix::operator()(const int i, const int j) {
+  CheckIndex_(i, j);
+  if (!IsStored_(i, j)) {
+    throw std::out_of_range("Index outside of stored triangle");
+  }
+  return data_[Index_(i, j)];
+}
+
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      if (IsStored_(i, j)) result(i, j) = data_[Index_(i, j)];
+    }
+  }
+  return result;
+}
+
+S21TriangularMatrix S21TriangularMatrix::Transpose() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  S21TriangularMatrix result(size_, (uplo_ == kLower) ? kUpper : kLower);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j < size_; j++) {
+      if (IsStored_(i, j)) {
+        result.data_[result.Index_(j, i)] = data_[Index_(i, j)];
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::MulMatrix(const S21Matrix& other) const {
+  if (size_ == 0 || size_ != other.GetRows()) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  S21Matrix result(size_, other.GetCols());
+  for (int i = 0; i < size_; i++) {
+    int from = (uplo_ == kLower) ? 0 : i;
+    int to = (uplo_ == kLower) ? i : size_ - 1;
+    for (int k = from; k <= to; k++) {
+      double a = data_[Index_(i, k)];
+      for (int j = 0; j < other.GetCols(); j++) {
+        result(i, j) += a * other.At(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix& b) const {
+  if (size_ == 0 || size_ != b.GetRows()) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  // The diagonal product underflows long before the matrix is singular, so
+  // look at the pivots one by one.
+  for (int i = 0; i < size_; i++) {
+    if (data_[Index_(i, i)] == 0) {
+      throw std::logic_error("Determinant = 0");
+    }
+  }
+  S21Matrix x(b);
+  for (int j = 0; j < x.GetCols(); j++) {
+    if (uplo_ == kLower) {
+      for (int i = 0; i < size_; i++) {
+        double sum = x(i, j);
+        for (int k = 0; k < i; k++) sum -= data_[Index_(i, k)] * x(k, j);
+        x(i, j) = sum / data_[Index_(i, i)];
+      }
+    } else {
+      for (int i = size_ - 1; i >= 0; i--) {
+        double sum = x(i, j);
+        for (int k = i + 1; k < size_; k++) {
+          sum -= data_[Index_(i, k)] * x(k, j);
+        }
+        x(i, j) = sum / data_[Index_(i, i)];
+      }
+    }
+  }
+  return x;
+}
+
+double S21TriangularMatrix::Determinant() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  double det = 1;
+  for (int i = 0; i < size_; i++) {
+    det *= data_[Index_(i, i)];
+  }
+  return det;
+}
+
+bool S21TriangularMatrix::IsStored_(const int i, const int j) const {
+  return (uplo_ == kLower) ? j <= i : j >= i;
+}
+
+int S21TriangularMatrix::Index_(const int i, const int j) const {
+  return (uplo_ == kLower) ? i * (i + 1) / 2 + j
+                           : i * size_ - i * (i - 1) / 2 + (j - i);
+}
+
+void S21TriangularMatrix::CheckIndex_(const int i, const int j) const {
+  if ((i < 0 || i >= size_) || (j < 0 || j >= size_)) {
+    throw std::out_of_range("Incorrect index");
+  }
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix() : size_(0) {}
+
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  if (size < 1) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  data_.assign(static_cast<size_t>(size_) * (size_ + 1) / 2, 0);
+}
+
+S21SymmetricMatrix::S21SymmetricMatrix(const S21Matrix& other)
+    : S21SymmetricMatrix(other.GetRows()) {
+  if (other.GetRows() != other.GetCols()) {
+    throw std::logic_error("Incorrect size of matrix");
+  }
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j <= i; j++) {
+      if (fabs(other.At(i, j) - other.At(j, i)) > EPS) {
+        throw std::logic_error("Matrix is not symmetric");
+      }
+      data_[Index_(i, j)] = other.At(i, j);
+    }
+  }
+}
+
+int S21SymmetricMatrix::GetSize() const { return size_; }
+
+double S21SymmetricMatrix::At(const int i, const int j) const {
+  CheckIndex_(i, j);
+  return data_[Index_(i, j)];
+}
+
+double& S21SymmetricMatrix::operator()(const int i, const int j) {
+  CheckIndex_(i, j);
+  return data_[Index_(i, j)];
+}
+
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    for (int j = 0; j <= i; j++) {
+      result(i, j) = result(j, i) = data_[Index_(i, j)];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::MulMatrix(const S21Matrix& other) const {
+  if (size_ == 0 || size_ != other.GetRows()) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  S21Matrix result(size_, other.GetCols());
+  for (int i = 0; i < size_; i++) {
+    for (int k = 0; k <= i; k++) {
+      double a = data_[Index_(i, k)];
+      for (int j = 0; j < other.GetCols(); j++) {
+        result(i, j) += a * other.At(k, j);
+        if (k != i) result(k, j) += a * other.At(i, j);
+      }
+    }
+  }
+  return result;
+}
+
+S21TriangularMatrix S21SymmetricMatrix::Cholesky() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  S21TriangularMatrix result(size_, S21TriangularMatrix::kLower);
+  for (int j = 0; j < size_; j++) {
+    double diag = data_[Index_(j, j)];
+    for (int k = 0; k < j; k++) diag -= result(j, k) * result(j, k);
+    if (diag <= 0) {
+      throw std::logic_error("Matrix is not positive definite");
+    }
+    result(j, j) = sqrt(diag);
+    for (int i = j + 1; i < size_; i++) {
+      double sum = data_[Index_(i, j)];
+      for (int k = 0; k < j; k++) sum -= result(i, k) * result(j, k);
+      result(i, j) = sum / result(j, j);
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::Solve(const S21Matrix& b) const {
+  if (size_ == 0 || size_ != b.GetRows()) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  S21TriangularMatrix lower;
+  try {
+    lower = Cholesky();
+  } catch (const std::logic_error&) {
+    // Indefinite: fall back to a pivoted LU, as Determinant() does.
+    return S21LU<double>(ToMatrix()).Solve(b);
+  }
+  return lower.Transpose().Solve(lower.Solve(b));
+}
+
+double S21SymmetricMatrix::Determinant() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  double result = 0;
+  try {
+    double diag = Cholesky().Determinant();
+    result = diag * diag;
+  } catch (const std::logic_error&) {
+    result = S21LU<double>(ToMatrix()).Determinant();
+  }
+  return result;
+}
+
+int S21SymmetricMatrix::Index_(const int i, const int j) const {
+  return (i >= j) ? i * (i + 1) / 2 + j : j * (j + 1) / 2 + i;
+}
+
+void S21SymmetricMatrix::CheckIndex_(const int i, const int j) const {
+  if ((i < 0 || i >= size_) || (j < 0 || j >= size_)) {
+    throw std::out_of_range("Incorrect index");
+  }
+}
+
+S21BandMatrix::S21BandMatrix() : size_(0), lower_(0), upper_(0) {}
+
+S21BandMatrix::S21BandMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  if (size < 1 || lower < 0 || upper < 0 || lower >= size || upper >= size) {
+    throw std::invalid_argument("Illegal parameters");
+  }
+  data_.assign(static_cast<size_t>(size_) * (lower_ + upper_ + 1), 0);
+}
+
+S21BandMatrix::S21BandMatrix(const S21Matrix& other, int lower, int upper)
+    : S21BandMatrix(other.GetRows(), lower, upper) {
+  if (other.GetRows() != other.GetCols()) {
+    throw std::logic_error("Incorrect size of matrix");
+  }
+  for (int i = 0; i < size_; i++) {
+    for (int j = std::max(0, i - lower_); j <= std::min(size_ - 1, i + upper_);
+         j++) {
+      data_[Index_(i, j)] = other.At(i, j);
+    }
+  }
+}
+
+int S21BandMatrix::GetSize() const { return size_; }
+
+int S21BandMatrix::GetLower() const { return lower_; }
+
+int S21BandMatrix::GetUpper() const { return upper_; }
+
+double S21BandMatrix::At(const int i, const int j) const {
+  CheckIndex_(i, j);
+  return IsStored_(i, j) ? data_[Index_(i, j)] : 0;
+}
+
+double& S21BandMatrix::operator()(const int i, const int j) {
+  CheckIndex_(i, j);
+  if (!IsStored_(i, j)) {
+    throw std::out_of_range("Index outside of stored band");
+  }
+  return data_[Index_(i, j)];
+}
+
+S21Matrix S21BandMatrix::ToMatrix() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; i++) {
+    for (int j = std::max(0, i - lower_); j <= std::min(size_ - 1, i + upper_);
+         j++) {
+      result(i, j) = data_[Index_(i, j)];
+    }
+  }
+  return result;
+}
+
+S21Matrix S21BandMatrix::MulMatrix(const S21Matrix& other) const {
+  if (size_ == 0 || size_ != other.GetRows()) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  S21Matrix result(size_, other.GetCols());
+  for (int i = 0; i < size_; i++) {
+    for (int k = std::max(0, i - lower_); k <= std::min(size_ - 1, i + upper_);
+         k++) {
+      double a = data_[Index_(i, k)];
+      for (int j = 0; j < other.GetCols(); j++) {
+        result(i, j) += a * other.At(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix S21BandMatrix::Solve(const S21Matrix& b) const {
+  if (size_ == 0 || size_ != b.GetRows()) {
+    throw std::logic_error("Incorrect dimension of matrices");
+  }
+  std::vector<double> lu;
+  std::vector<int> pivots;
+  int sign = 1;
+  if (!FactorizeLU_(lu, pivots, sign)) {
+    throw std::logic_error("Determinant = 0");
+  }
+  int width = 2 * lower_ + upper_ + 1;
+  int upper = lower_ + upper_;
+  S21Matrix x(b);
+  for (int j = 0; j < x.GetCols(); j++) {
+    for (int k = 0; k < size_; k++) {
+      if (pivots[k] != k) std::swap(x(k, j), x(pivots[k], j));
+      for (int i = k + 1; i <= std::min(size_ - 1, k + lower_); i++) {
+        x(i, j) -= lu[i * width + (k - i + lower_)] * x(k, j);
+      }
+    }
+    for (int i = size_ - 1; i >= 0; i--) {
+      double sum = x(i, j);
+      for (int k = i + 1; k <= std::min(size_ - 1, i + upper); k++) {
+        sum -= lu[i * width + (k - i + lower_)] * x(k, j);
+      }
+      x(i, j) = sum / lu[i * width + lower_];
+    }
+  }
+  return x;
+}
+
+double S21BandMatrix::Determinant() const {
+  if (size_ == 0) {
+    throw std::logic_error("Incorrect matrix");
+  }
+  std::vector<double> lu;
+  std::vector<int> pivots;
+  int sign = 1;
+  double det = 0;
+  if (FactorizeLU_(lu, pivots, sign)) {
+    det = sign;
+    for (int i = 0; i < size_; i++) {
+      det *= lu[i * (2 * lower_ + upper_ + 1) + lower_];
+    }
+  }
+  return det;
+}
+
+bool S21BandMatrix::FactorizeLU_(std::vector<double>& lu,
+                                 std::vector<int>& pivots, int& sign) const {
+  // Banded LU with partial pivoting as in LAPACK's gbtrf. Row swaps widen
+  // the upper band of U to lower_ + upper_, so every row keeps lower_ extra
+  // slots for the fill-in. Multipliers stay where they were computed and
+  // the solve replays the swaps step by step.
+  int width = 2 * lower_ + upper_ + 1;
+  int upper = lower_ + upper_;
+  lu.assign(static_cast<size_t>(size_) * width, 0);
+  pivots.resize(size_);
+  for (int i = 0; i < size_; i++) {
+    for (int j = std::max(0, i - lower_); j <= std::min(size_ - 1, i + upper_);
+         j++) {
+      lu[i * width + (j - i + lower_)] = data_[Index_(i, j)];
+    }
+  }
+  bool result = true;
+  for (int k = 0; k < size_; k++) {
+    int last_row = std::min(size_ - 1, k + lower_);
+    int last_col = std::min(size_ - 1, k + upper);
+    int pivot = k;
+    for (int i = k + 1; i <= last_row; i++) {
+      if (fabs(lu[i * width + (k - i + lower_)]) >
+          fabs(lu[pivot * width + (k - pivot + lower_)])) {
+        pivot = i;
+      }
+    }
+    pivots[k] = pivot;
+    if (lu[pivot * width + (k - pivot + lower_)] == 0) {
+      result = false;
+      continue;
+    }
+    if (pivot != k) {
+      for (int j = k; j <= last_col; j++) {
+        std::swap(lu[k * width + (j - k + lower_)],
+                  lu[pivot * width + (j - pivot + lower_)]);
+      }
+      sign = -sign;
+    }
+    double diag = lu[k * width + lower_];
+    for (int i = k + 1; i <= last_row; i++) {
+      double factor = lu[i * width + (k - i + lower_)] / diag;
+      lu[i * width + (k - i + lower_)] = factor;
+      for (int j = k + 1; j <= last_col; j++) {
+        lu[i * width + (j - i + lower_)] -=
+            factor * lu[k * width + (j - k + lower_)];
+      }
+    }
+  }
+  return result;
+}
+
+bool S21BandMatrix::IsStored_(const int i, const int j) const {
+  return j >= i - lower_ && j <= i + upper_;
+}
+
+int S21BandMatrix::Index_(const int i, const int j) const {
+  return i * (lower_ + upper_ + 1) + (j - i + lower_);
+}
+
+void S21BandMatrix::CheckIndex_(const int i, const int j) const {
+  if ((i < 0 || i >= size_) || (j < 0 || j >= size_)) {
+    throw std::out_of_range("Incorrect index");
+  }
+}
@@ -0,0 +1,92 @@
+#ifndef SRC_S21_STRUCTURED_MATRIX_H_
+#define SRC_S21_STRUCTURED_MATRIX_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+class S21TriangularMatrix {
+ public:
+  enum Uplo { kLower, kUpper };
+
+  S21TriangularMatrix();
+  S21TriangularMatrix(int size, Uplo uplo);
+  S21TriangularMatrix(const S21Matrix& other, Uplo uplo);
+
+  int GetSize() const;
+  Uplo GetUplo() const;
+
+  double At(const int i, const int j) const;
+  double& operator()(const int i, const int j);
+
+  S21Matrix ToMatrix() const;
+  S21TriangularMatrix Transpose() const;
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21Matrix Solve(const S21Matrix& b) const;
+  double Determinant() const;
+
+ private:
+  int size_;
+  Uplo uplo_;
+  std::vector<double> data_;
+
+  bool IsStored_(const int i, const int j) const;
+  int Index_(const int i, const int j) const;
+  void CheckIndex_(const int i, const int j) const;
+};
+
+class S21SymmetricMatrix {
+ public:
+  S21SymmetricMatrix();
+  explicit S21SymmetricMatrix(int size);
+  explicit S21SymmetricMatrix(const S21Matrix& other);
+
+  int GetSize() const;
+
+  double At(const int i, const int j) const;
+  double& operator()(const int i, const int j);
+
+  S21Matrix ToMatrix() const;
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21TriangularMatrix Cholesky() const;
+  S21Matrix Solve(const S21Matrix& b) const;
+  double Determinant() const;
+
+ private:
+  int size_;
+  std::vector<double> data_;
+
+  int Index_(const int i, const int j) const;
+  void CheckIndex_(const int i, const int j) const;
+};
+
+class S21BandMatrix {
+ public:
+  S21BandMatrix();
+  S21BandMatrix(int size, int lower, int upper);
+  S21BandMatrix(const S21Matrix& other, int lower, int upper);
+
+  int GetSize() const;
+  int GetLower() const;
+  int GetUpper() const;
+
+  double At(const int i, const int j) const;
+  double& operator()(const int i, const int j);
+
+  S21Matrix ToMatrix() const;
+  S21Matrix MulMatrix(const S21Matrix& other) const;
+  S21Matrix Solve(const S21Matrix& b) const;
+  double Determinant() const;
+
+ private:
+  int size_, lower_, upper_;
+  std::vector<double> data_;
+
+  bool IsStored_(const int i, const int j) const;
+  int Index_(const int i, const int j) const;
+  void CheckIndex_(const int i, const int j) const;
+  bool FactorizeLU_(std::vector<double>& lu, std::vector<int>& pivots,
+                    int& sign) const;
+};
+
+#endif  // SRC_S21_STRUCTURED_MATRIX_H_
@@ -1,6 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <utility>
+
+#include "../s21_decomposition.h"
+#include "../s21_inverse_updater.h"
+#include "../s21_lu.h"
 #include "../s21_matrix_oop.h"
+#include "../s21_mixed_solver.h"
+#include "../s21_structured_matrix.h"
 
 void fillMatrixWithStep(const S21Matrix &m, double step) {
   double num = 0;
@@ -463,6 +471,650 @@ TEST(test, operator_eq_1) {
   EXPECT_TRUE(m2 == m3);
 }
 
+TEST(test, triangular_1) {
+  S21Matrix m = S21Matrix(3, 3);
+  fillMatrixWithStep(m, 1);
+  S21TriangularMatrix lower(m, S21TriangularMatrix::kLower);
+  EXPECT_EQ(lower.At(2, 1), 7);
+  EXPECT_EQ(lower.At(0, 2), 0);
+  EXPECT_THROW(lower(0, 2), std::out_of_range);
+  EXPECT_EQ(lower.Determinant(), 0);
+  lower(0, 0) = 2;
+  EXPECT_EQ(lower.Determinant(), 2 * 4 * 8);
+  EXPECT_EQ(lower.Determinant(), lower.ToMatrix().Determinant());
+}
+
+TEST(test, triangular_2) {
+  S21Matrix m = S21Matrix(4, 4);
+  fillMatrixWithStep(m, 1.5);
+  for (int i = 0; i < 4; i++) m(i, i) += 10;
+  S21TriangularMatrix upper(m, S21TriangularMatrix::kUpper);
+  S21Matrix b = S21Matrix(4, 2);
+  fillMatrixWithStep(b, 0.5);
+  S21Matrix x = upper.Solve(b);
+  EXPECT_TRUE(upper.MulMatrix(x) == b);
+  EXPECT_TRUE(upper.MulMatrix(x) == upper.ToMatrix() * x);
+  EXPECT_TRUE(upper.Transpose().ToMatrix() == upper.ToMatrix().Transpose());
+}
+
+TEST(test, triangular_3) {
+  S21TriangularMatrix t(2, S21TriangularMatrix::kLower);
+  EXPECT_THROW(t.Solve(S21Matrix(2, 1)), std::logic_error);
+  EXPECT_THROW(t.Solve(S21Matrix(3, 1)), std::logic_error);
+  EXPECT_THROW(S21TriangularMatrix(0, S21TriangularMatrix::kUpper),
+               std::invalid_argument);
+  EXPECT_THROW(S21TriangularMatrix().Determinant(), std::logic_error);
+}
+
+TEST(test, symmetric_1) {
+  S21Matrix m = S21Matrix(3, 3);
+  m(0, 0) = 4;
+  m(0, 1) = m(1, 0) = 12;
+  m(0, 2) = m(2, 0) = -16;
+  m(1, 1) = 37;
+  m(1, 2) = m(2, 1) = -43;
+  m(2, 2) = 98;
+  S21SymmetricMatrix s(m);
+  EXPECT_EQ(s.At(0, 2), s.At(2, 0));
+  S21TriangularMatrix l = s.Cholesky();
+  EXPECT_DOUBLE_EQ(l.At(0, 0), 2);
+  EXPECT_DOUBLE_EQ(l.At(1, 0), 6);
+  EXPECT_DOUBLE_EQ(l.At(2, 1), 5);
+  EXPECT_DOUBLE_EQ(l.At(2, 2), 3);
+  EXPECT_DOUBLE_EQ(s.Determinant(), 36);
+  EXPECT_TRUE(s.ToMatrix() == m);
+}
+
+TEST(test, symmetric_2) {
+  S21SymmetricMatrix s(3);
+  s(0, 0) = 5;
+  s(1, 1) = 6;
+  s(2, 2) = 7;
+  s(1, 0) = 1;
+  s(2, 1) = -2;
+  S21Matrix b = S21Matrix(3, 2);
+  fillMatrixWithStep(b, 1);
+  S21Matrix x = s.Solve(b);
+  EXPECT_TRUE(s.MulMatrix(x) == b);
+  EXPECT_TRUE(s.MulMatrix(b.Transpose().Transpose()) == s.ToMatrix() * b);
+}
+
+TEST(test, symmetric_3) {
+  S21Matrix m = S21Matrix(2, 2);
+  fillMatrixWithStep(m, 1);
+  EXPECT_THROW(S21SymmetricMatrix s(m), std::logic_error);
+  S21SymmetricMatrix s(2);
+  s(0, 1) = 3;
+  EXPECT_THROW(s.Cholesky(), std::logic_error);
+  EXPECT_DOUBLE_EQ(s.Determinant(), -9);
+}
+
+TEST(test, band_1) {
+  S21BandMatrix b(5, 1, 1);
+  for (int i = 0; i < 5; i++) {
+    b(i, i) = 4;
+    if (i > 0) b(i, i - 1) = -1;
+    if (i < 4) b(i, i + 1) = -1;
+  }
+  EXPECT_THROW(b(0, 2), std::out_of_range);
+  EXPECT_EQ(b.At(0, 2), 0);
+  EXPECT_FLOAT_EQ(b.Determinant(), b.ToMatrix().Determinant());
+  S21Matrix rhs = S21Matrix(5, 1);
+  fillMatrixWithStep(rhs, 1);
+  S21Matrix x = b.Solve(rhs);
+  EXPECT_TRUE(b.MulMatrix(x) == rhs);
+  EXPECT_TRUE(S21BandMatrix(b.ToMatrix(), 1, 1).ToMatrix() == b.ToMatrix());
+}
+
+TEST(test, band_2) {
+  S21BandMatrix b(3, 1, 0);
+  b(1, 0) = 1;
+  b(2, 1) = 1;
+  EXPECT_THROW(b.Solve(S21Matrix(3, 1)), std::logic_error);
+  EXPECT_EQ(b.Determinant(), 0);
+  EXPECT_THROW(S21BandMatrix(3, 3, 0), std::invalid_argument);
+}
+
+TEST(test, copy_on_write_1) {
+  S21Matrix m1 = S21Matrix(3, 3);
+  fillMatrixWithStep(m1, 1);
+  m1.SetCopyOnWrite(true);
+  S21Matrix m2(m1);
+  S21Matrix m3;
+  m3 = m1;
+  EXPECT_TRUE(m1.IsShared());
+  EXPECT_TRUE(m2.IsCopyOnWrite());
+  EXPECT_EQ(m1.At(2, 2), m2.At(2, 2));
+  EXPECT_TRUE(m2.IsShared());
+  m2(1, 1) = -5;
+  EXPECT_FALSE(m2.IsShared());
+  EXPECT_EQ(m1(1, 1), 4);
+  EXPECT_EQ(m3(1, 1), 4);
+  EXPECT_EQ(m2(1, 1), -5);
+}
+
+TEST(test, copy_on_write_2) {
+  S21Matrix m1 = S21Matrix(2, 2);
+  fillMatrixWithStep(m1, 1);
+  m1.SetCopyOnWrite(true);
+  S21Matrix m2 = m1;
+  m2 += m1;
+  m2 *= 2;
+  EXPECT_EQ(m1(1, 1), 3);
+  EXPECT_EQ(m2(1, 1), 12);
+  S21Matrix m3 = m1;
+  m3 *= m1;
+  m3.SetRows(3);
+  EXPECT_TRUE(m3.IsCopyOnWrite());
+  EXPECT_EQ(m1.GetRows(), 2);
+  EXPECT_EQ(m3(1, 1), 11);
+  S21Matrix m4 = m1 + m1;
+  EXPECT_FALSE(m1.IsShared());
+  EXPECT_EQ(m4(1, 0), 4);
+}
+
+TEST(test, copy_on_write_3) {
+  S21Matrix m1 = S21Matrix(2, 2);
+  m1.SetCopyOnWrite(true);
+  S21Matrix m2 = m1;
+  m2.SetCopyOnWrite(false);
+  EXPECT_FALSE(m2.IsCopyOnWrite());
+  EXPECT_FALSE(m1.IsShared());
+  S21Matrix m3 = m2;
+  EXPECT_FALSE(m3.IsCopyOnWrite());
+  S21Matrix empty;
+  EXPECT_THROW(empty.SetCopyOnWrite(true), std::logic_error);
+}
+
+TEST(test, copy_on_write_5) {
+  S21Matrix m = S21Matrix(2, 2);
+  m.SetCopyOnWrite(true);
+  double& ref = m(0, 0);
+  S21Matrix copy = m;
+  ref = 5;
+  EXPECT_EQ(copy.At(0, 0), 0);
+  EXPECT_EQ(m.At(0, 0), 5);
+  EXPECT_TRUE(copy.IsCopyOnWrite());
+  EXPECT_FALSE(m.IsShared());
+  S21Matrix shared = copy;
+  EXPECT_TRUE(copy.IsShared());
+}
+
+TEST(test, copy_on_write_6) {
+  S21Matrix model = S21Matrix(3, 3);
+  fillMatrixWithStep(model, 1);
+  model.SetCopyOnWrite(true);
+  S21Matrix first = model;
+  const S21Matrix& cref = model;
+  double sum = 0;
+  std::thread reader([&cref, &sum]() {
+    for (int i = 0; i < 1000; i++) sum += cref(1, 1);
+  });
+  for (int i = 0; i < 1000; i++) {
+    S21Matrix copy = cref;
+    EXPECT_EQ(copy.At(2, 2), 8);
+  }
+  reader.join();
+  EXPECT_EQ(sum, 4000);
+  EXPECT_EQ(first.At(1, 1), 4);
+}
+
+TEST(test, triangular_4) {
+  S21TriangularMatrix t(400, S21TriangularMatrix::kLower);
+  for (int i = 0; i < 400; i++) t(i, i) = 0.1;
+  S21Matrix b = S21Matrix(400, 1);
+  fillMatrix(b, 1);
+  EXPECT_EQ(t.Determinant(), 0);
+  S21Matrix x = t.Solve(b);
+  EXPECT_DOUBLE_EQ(x(399, 0), 10);
+}
+
+TEST(test, symmetric_4) {
+  S21SymmetricMatrix s(400);
+  for (int i = 0; i < 400; i++) s(i, i) = 0.01;
+  S21Matrix b = S21Matrix(400, 1);
+  fillMatrix(b, 1);
+  S21Matrix x = s.Solve(b);
+  EXPECT_DOUBLE_EQ(x(0, 0), 100);
+  S21SymmetricMatrix indefinite(12);
+  for (int i = 0; i < 12; i++) {
+    for (int j = 0; j <= i; j++) indefinite(i, j) = sin(i * 3 + j);
+  }
+  S21Matrix dense = indefinite.ToMatrix();
+  EXPECT_THROW(indefinite.Cholesky(), std::logic_error);
+  EXPECT_NEAR(indefinite.Determinant(), S21LU<double>(dense).Determinant(),
+              1e-9);
+  S21Matrix rhs = S21Matrix(12, 1);
+  fillMatrixWithStep(rhs, 1);
+  EXPECT_TRUE(dense * indefinite.Solve(rhs) == rhs);
+  S21SymmetricMatrix swap(2);
+  swap(1, 0) = 1;
+  S21Matrix b2 = S21Matrix(2, 1);
+  b2(0, 0) = 3;
+  b2(1, 0) = 4;
+  S21Matrix x2 = swap.Solve(b2);
+  EXPECT_EQ(x2(0, 0), 4);
+  EXPECT_EQ(x2(1, 0), 3);
+  EXPECT_EQ(swap.Determinant(), -1);
+  EXPECT_THROW(S21SymmetricMatrix(2).Solve(b2), std::logic_error);
+}
+
+TEST(test, band_3) {
+  S21BandMatrix b(2, 1, 1);
+  b(0, 1) = 1;
+  b(1, 0) = 1;
+  EXPECT_EQ(b.Determinant(), -1);
+  S21Matrix rhs = S21Matrix(2, 1);
+  rhs(0, 0) = 3;
+  rhs(1, 0) = 4;
+  S21Matrix x = b.Solve(rhs);
+  EXPECT_EQ(x(0, 0), 4);
+  EXPECT_EQ(x(1, 0), 3);
+}
+
+TEST(test, band_4) {
+  const int size = 30;
+  S21BandMatrix b(size, 2, 1);
+  for (int i = 0; i < size; i++) {
+    for (int j = std::max(0, i - 2); j <= std::min(size - 1, i + 1); j++) {
+      b(i, j) = cos(i * 5 + j * 2);
+    }
+  }
+  S21Matrix dense = b.ToMatrix();
+  EXPECT_NEAR(b.Determinant(), S21LU<double>(dense).Determinant(), 1e-9);
+  S21Matrix rhs = S21Matrix(size, 2);
+  fillMatrixWithStep(rhs, 0.5);
+  EXPECT_TRUE(b.MulMatrix(b.Solve(rhs)) == rhs);
+}
+
+TEST(test, lu_1) {
+  S21Matrix m = S21Matrix(4, 4);
+  fillMatrixWithStep(m, 1.1);
+  m(0, 0) = 11;
+  m(2, 2) = 11;
+  m(3, 2) = -10;
+  S21LU<double> lu(m);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_FLOAT_EQ(lu.Determinant(), m.Determinant());
+  EXPECT_TRUE(lu.Inverse() == m.InverseMatrix());
+}
+
+TEST(test, lu_2) {
+  S21Matrix m = S21Matrix(3, 3);
+  fillMatrixWithStep(m, 2);
+  S21LU<double> lu(m);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_EQ(lu.Determinant(), 0);
+  EXPECT_THROW(lu.Solve(S21Matrix(3, 1)), std::logic_error);
+  EXPECT_THROW(S21LU<double>(S21Matrix(2, 3)), std::logic_error);
+}
+
+TEST(test, inverse_updater_1) {
+  S21Matrix m = S21Matrix(4, 4);
+  fillMatrixWithStep(m, 1);
+  for (int i = 0; i < 4; i++) m(i, i) += 20;
+  S21InverseUpdater updater(m);
+  S21Matrix u = S21Matrix(4, 1);
+  S21Matrix v = S21Matrix(1, 4);
+  fillMatrixWithStep(u, 0.5);
+  fillMatrixWithStep(v, -0.25);
+  updater.RankOneUpdate(u, v);
+  S21Matrix expect = m + u * v;
+  EXPECT_EQ(updater.GetUpdatesSinceRefactor(), 1);
+  EXPECT_TRUE(updater.GetMatrix() == expect);
+  EXPECT_TRUE(updater.GetInverse() == expect.InverseMatrix());
+  EXPECT_FLOAT_EQ(updater.GetDeterminant(), expect.Determinant());
+}
+
+TEST(test, inverse_updater_2) {
+  S21Matrix m = S21Matrix(3, 3);
+  fillMatrixWithStep(m, 1);
+  m(2, 2) = 10;
+  S21InverseUpdater updater(m, 2);
+  S21Matrix row = S21Matrix(1, 3);
+  fillMatrixWithStep(row, 3);
+  row(0, 0) = 1;
+  updater.ReplaceRow(1, row);
+  m(1, 0) = 1;
+  m(1, 1) = 3;
+  m(1, 2) = 6;
+  EXPECT_TRUE(updater.GetInverse() == m.InverseMatrix());
+  EXPECT_FLOAT_EQ(updater.GetDeterminant(), m.Determinant());
+  row(0, 1) = 7;
+  updater.ReplaceRow(0, row);
+  m(0, 0) = 1;
+  m(0, 1) = 7;
+  m(0, 2) = 6;
+  EXPECT_EQ(updater.GetUpdatesSinceRefactor(), 0);
+  EXPECT_TRUE(updater.GetInverse() == m.InverseMatrix());
+}
+
+TEST(test, inverse_updater_3) {
+  S21Matrix m = S21Matrix(2, 2);
+  m(0, 0) = 1;
+  m(1, 1) = 1;
+  S21InverseUpdater updater(m);
+  S21Matrix row = S21Matrix(1, 2);
+  row(0, 0) = 1;
+  EXPECT_THROW(updater.ReplaceRow(1, row), std::logic_error);
+  EXPECT_TRUE(updater.GetMatrix() == m);
+  EXPECT_EQ(updater.GetDeterminant(), 1);
+  EXPECT_THROW(updater.ReplaceRow(2, row), std::out_of_range);
+  EXPECT_THROW(updater.RankOneUpdate(S21Matrix(3, 1), row), std::logic_error);
+  EXPECT_THROW(S21InverseUpdater(S21Matrix(2, 2)), std::logic_error);
+}
+
+TEST(test, mixed_solver_1) {
+  S21Matrix m = S21Matrix(5, 5);
+  fillMatrixWithStep(m, 0.37);
+  for (int i = 0; i < 5; i++) m(i, i) += 7.1;
+  S21Matrix b = S21Matrix(5, 2);
+  fillMatrixWithStep(b, 1.3);
+  S21MixedSolver solver(m);
+  S21Matrix x = solver.Solve(b);
+  EXPECT_FALSE(solver.IsFallback());
+  EXPECT_GT(solver.GetIterations(), 0);
+  EXPECT_LE(solver.GetResidual(), S21MixedSolver::kDefaultTolerance);
+  EXPECT_TRUE(m * x == b);
+}
+
+TEST(test, mixed_solver_2) {
+  S21Matrix m = S21Matrix(3, 3);
+  m(0, 0) = 1;
+  m(0, 1) = 1;
+  m(1, 0) = 1;
+  m(1, 1) = 1 + 1e-9;
+  m(2, 2) = 1;
+  S21Matrix b = S21Matrix(3, 1);
+  fillMatrixWithStep(b, 1);
+  S21MixedSolver solver(m);
+  S21Matrix x = solver.Solve(b);
+  EXPECT_TRUE(solver.IsFallback());
+  EXPECT_TRUE(m * x == b);
+  b(0, 0) = 5;
+  x = solver.Solve(b);
+  EXPECT_TRUE(solver.IsFallback());
+  EXPECT_EQ(solver.GetIterations(), 0);
+  EXPECT_TRUE(m * x == b);
+  EXPECT_THROW(solver.Solve(S21Matrix(2, 1)), std::logic_error);
+  EXPECT_THROW(S21MixedSolver(m, -1), std::invalid_argument);
+}
+
+TEST(test, copy_on_write_4) {
+  S21Matrix a = S21Matrix(2, 2);
+  fillMatrixWithStep(a, 1);
+  a.SetCopyOnWrite(true);
+  S21Matrix b = a;
+  EXPECT_EQ(b.At(1, 1), 3);
+  EXPECT_TRUE(a.IsShared());
+  std::as_const(a)(0, 0) = 9;
+  EXPECT_FALSE(a.IsShared());
+  EXPECT_EQ(a.At(0, 0), 9);
+  EXPECT_EQ(b.At(0, 0), 0);
+  EXPECT_FALSE(b.IsShared());
+  EXPECT_EQ(b.Determinant(), -2);
+  EXPECT_THROW(b.At(2, 0), std::out_of_range);
+}
+
+TEST(test, gemm_1) {
+  S21Matrix a = S21Matrix(3, 4);
+  S21Matrix b = S21Matrix(2, 4);
+  S21Matrix c = S21Matrix(3, 2);
+  fillMatrixWithStep(a, 1.5);
+  fillMatrixWithStep(b, -0.5);
+  fillMatrixWithStep(c, 2);
+  S21Matrix expect = a * b.Transpose() * 0.5 + c;
+  c.Gemm(0.5, a, false, b, true, 1);
+  EXPECT_TRUE(c == expect);
+  S21Matrix d = S21Matrix(4, 4);
+  fillMatrix(d, NAN);
+  d.Gemm(2, a, true, a, false, 0);
+  EXPECT_TRUE(d == a.Transpose() * a * 2);
+  S21Matrix e = S21Matrix(2, 3);
+  e.Gemm(1, b, false, a, true, 0);
+  EXPECT_TRUE(e == b * a.Transpose());
+  S21Matrix g = S21Matrix(2, 3);
+  S21Matrix f = S21Matrix(4, 2);
+  fillMatrixWithStep(g, 0.75);
+  f.Gemm(-1, a, true, g, true, 0);
+  EXPECT_TRUE(f == (g * a).Transpose() * -1);
+}
+
+TEST(test, gemm_2) {
+  S21Matrix a = S21Matrix(3, 3);
+  fillMatrixWithStep(a, 1);
+  S21Matrix expect = a * a + a * 2;
+  a.Gemm(1, a, false, a, false, 2);
+  EXPECT_TRUE(a == expect);
+  S21Matrix shared = S21Matrix(3, 3);
+  fillMatrixWithStep(shared, 1);
+  shared.SetCopyOnWrite(true);
+  S21Matrix c = shared;
+  c.Gemm(1, shared, true, shared, false, -1);
+  EXPECT_TRUE(c == shared.Transpose() * shared - shared);
+  EXPECT_FALSE(shared.IsShared());
+  EXPECT_THROW(c.Gemm(1, S21Matrix(2, 3), false, shared, false, 0),
+               std::logic_error);
+  EXPECT_THROW(c.Gemm(1, S21Matrix(), false, shared, false, 0),
+               std::logic_error);
+}
+
+TEST(test, eq_6) {
+  S21Matrix m1 = S21Matrix(200, 150);
+  S21Matrix m2 = S21Matrix(200, 150);
+  fillMatrixWithStep(m1, 0.1);
+  fillMatrixWithStep(m2, 0.1);
+  EXPECT_TRUE(m1.EqMatrixExact(m2));
+  m2(199, 149) += EPS / 2;
+  EXPECT_FALSE(m1.EqMatrixExact(m2));
+  EXPECT_TRUE(m1.EqMatrix(m2));
+  m2(0, 0) = 1;
+  EXPECT_FALSE(m1.EqMatrix(m2));
+  EXPECT_FALSE(m1.EqMatrixExact(S21Matrix(150, 200)));
+  EXPECT_THROW(m1.EqMatrixExact(S21Matrix()), std::logic_error);
+}
+
+TEST(test, hash_1) {
+  S21Matrix m1 = S21Matrix(3, 4);
+  S21Matrix m2 = S21Matrix(3, 4);
+  fillMatrixWithStep(m1, 1.25);
+  fillMatrixWithStep(m2, 1.25);
+  EXPECT_EQ(m1.Hash(), m2.Hash());
+  EXPECT_NE(m1.Hash(), m1.Transpose().Hash());
+  m2(2, 3) += 1e-12;
+  EXPECT_NE(m1.Hash(), m2.Hash());
+  EXPECT_EQ(m1.HashApprox(), m2.HashApprox());
+  m2(0, 0) = -0.0;
+  EXPECT_EQ(m1.HashApprox(), m2.HashApprox());
+  m2(0, 0) = 1;
+  EXPECT_NE(m1.HashApprox(), m2.HashApprox());
+  EXPECT_THROW(S21Matrix().Hash(), std::logic_error);
+  EXPECT_THROW(m1.HashApprox(0), std::invalid_argument);
+}
+
+TEST(test, result_cache_1) {
+  S21Matrix m = S21Matrix(4, 4);
+  fillMatrixWithStep(m, 1.1);
+  m(0, 0) = 11;
+  m(2, 2) = 11;
+  m(3, 2) = -10;
+  S21Matrix::ResetCacheStats();
+  double det = m.Determinant();
+  S21Matrix inverse = m.InverseMatrix();
+  EXPECT_EQ(S21Matrix::GetCacheMisses(), 2u);
+  EXPECT_EQ(m.Determinant(), det);
+  EXPECT_TRUE(m.InverseMatrix() == inverse);
+  EXPECT_EQ(m.Factorization(), m.Factorization());
+  EXPECT_EQ(S21Matrix::GetCacheHits(), 3u);
+  EXPECT_EQ(S21Matrix::GetCacheMisses(), 3u);
+  S21Matrix copy = m;
+  EXPECT_EQ(copy.Determinant(), det);
+  EXPECT_EQ(S21Matrix::GetCacheHits(), 4u);
+}
+
+TEST(test, result_cache_2) {
+  S21Matrix m = S21Matrix(3, 3);
+  fillMatrixWithStep(m, 1);
+  m(2, 2) = 10;
+  EXPECT_DOUBLE_EQ(m.Determinant(), -6);
+  uint64_t generation = m.GetGeneration();
+  m(2, 2) = 11;
+  EXPECT_EQ(m.GetGeneration(), generation);
+  EXPECT_DOUBLE_EQ(m.Determinant(), -9);
+  m *= 1;
+  EXPECT_NE(m.GetGeneration(), generation);
+  fillMatrix(m, 1);
+  EXPECT_DOUBLE_EQ(m.Determinant(), 0);
+  EXPECT_THROW(m.InverseMatrix(), std::logic_error);
+  S21Matrix::ResetCacheStats();
+  m.MulNumber(2);
+  m(0, 0) = 5;
+  EXPECT_DOUBLE_EQ(m.Determinant(), 0);
+  m.SetRows(2);
+  m.SetCols(2);
+  EXPECT_DOUBLE_EQ(m.Determinant(), 6);
+  EXPECT_EQ(S21Matrix::GetCacheHits(), 0u);
+  EXPECT_EQ(S21Matrix::GetCacheMisses(), 2u);
+}
+
+TEST(test, result_cache_3) {
+  S21Matrix m = S21Matrix(2, 2);
+  fillMatrixWithStep(m, 1);
+  double& ref = m(0, 0);
+  EXPECT_DOUBLE_EQ(m.Determinant(), -2);
+  ref = 5;
+  EXPECT_DOUBLE_EQ(m.Determinant(), 13);
+  S21Matrix::ResetCacheStats();
+  EXPECT_EQ(m(1, 1), 3);
+  EXPECT_DOUBLE_EQ(m.Determinant(), 13);
+  EXPECT_EQ(S21Matrix::GetCacheHits(), 1u);
+  EXPECT_EQ(S21Matrix::GetCacheMisses(), 0u);
+  S21Matrix sum = m + m;
+  EXPECT_DOUBLE_EQ(sum.Determinant(), 52);
+  double& first = sum(0, 0);
+  first = 0;
+  EXPECT_DOUBLE_EQ(sum.Determinant(), -8);
+}
+
+TEST(test, allocation_policy_1) {
+  S21Matrix::SetAllocationPolicy(true, 4);
+  S21Matrix m = S21Matrix(700, 800);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&std::as_const(m)(0, 0)) % (2 << 20),
+            0u);
+  EXPECT_EQ(m(699, 799), 0);
+  EXPECT_EQ(m(350, 0), 0);
+  fillMatrixWithStep(m, 1);
+  S21Matrix copy(m);
+  EXPECT_TRUE(copy.EqMatrixExact(m));
+  EXPECT_EQ(m.Transpose()(799, 699), 559999);
+  S21Matrix::SetAllocationPolicy(false, 1);
+  EXPECT_THROW(S21Matrix::SetAllocationPolicy(false, 0),
+               std::invalid_argument);
+}
+
+TEST(test, row_block_1) {
+  int covered = 0;
+  for (int t = 0; t < 4; t++) {
+    std::pair<int, int> block = S21Matrix::RowBlock(10, 4, t);
+    EXPECT_EQ(block.first, covered);
+    EXPECT_GE(block.second - block.first, 2);
+    covered = block.second;
+  }
+  EXPECT_EQ(covered, 10);
+  EXPECT_THROW(S21Matrix::RowBlock(10, 4, 4), std::invalid_argument);
+}
+
+S21Matrix diagonalMatrix(const S21Matrix &values) {
+  S21Matrix result = S21Matrix(values.GetRows(), values.GetRows());
+  for (int i = 0; i < values.GetRows(); i++) result(i, i) = values(i, 0);
+  return result;
+}
+
+S21Matrix identityMatrix(int size) {
+  S21Matrix result = S21Matrix(size, size);
+  for (int i = 0; i < size; i++) result(i, i) = 1;
+  return result;
+}
+
+TEST(test, symmetric_eigen_1) {
+  S21Matrix m = S21Matrix(3, 3);
+  m(0, 0) = 2;
+  m(0, 1) = m(1, 0) = -1;
+  m(1, 1) = 2;
+  m(1, 2) = m(2, 1) = -1;
+  m(2, 2) = 2;
+  S21SymmetricEigen eigen(m);
+  S21Matrix values = eigen.GetEigenvalues();
+  EXPECT_NEAR(values(0, 0), 2 - sqrt(2), 1e-12);
+  EXPECT_NEAR(values(1, 0), 2, 1e-12);
+  EXPECT_NEAR(values(2, 0), 2 + sqrt(2), 1e-12);
+  S21Matrix z = eigen.GetEigenvectors();
+  EXPECT_TRUE(z * diagonalMatrix(values) * z.Transpose() == m);
+  EXPECT_TRUE(z.Transpose() * z == identityMatrix(3));
+}
+
+TEST(test, symmetric_eigen_2) {
+  const int size = 40;
+  S21Matrix m = S21Matrix(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j <= i; j++) {
+      m(i, j) = m(j, i) = sin(i * 7 + j * 3) + (i == j ? 2 : 0);
+    }
+  }
+  S21SymmetricEigen eigen(m);
+  S21Matrix z = eigen.GetEigenvectors();
+  S21Matrix values = eigen.GetEigenvalues();
+  EXPECT_TRUE(z * diagonalMatrix(values) * z.Transpose() == m);
+  EXPECT_TRUE(z.Transpose() * z == identityMatrix(size));
+  for (int i = 1; i < size; i++) EXPECT_LE(values(i - 1, 0), values(i, 0));
+  S21Matrix one = S21Matrix(1, 1);
+  one(0, 0) = -3;
+  EXPECT_EQ(S21SymmetricEigen(one).GetEigenvalues()(0, 0), -3);
+  m(0, 1) = 5;
+  EXPECT_THROW(S21SymmetricEigen eigen(m), std::logic_error);
+  EXPECT_THROW(S21SymmetricEigen(S21Matrix(2, 3)), std::logic_error);
+}
+
+TEST(test, svd_1) {
+  S21Matrix m = S21Matrix(50, 37);
+  unsigned seed = 7;
+  for (int i = 0; i < 50; i++) {
+    for (int j = 0; j < 37; j++) {
+      seed = seed * 1103515245u + 12345u;
+      m(i, j) = (seed >> 16) % 1000 / 100.0 - 5;
+    }
+  }
+  S21SVD svd(m);
+  S21Matrix u = svd.GetU();
+  S21Matrix s = svd.GetSingularValues();
+  S21Matrix v = svd.GetV();
+  EXPECT_EQ(u.GetRows(), 50);
+  EXPECT_EQ(u.GetCols(), 37);
+  EXPECT_EQ(v.GetRows(), 37);
+  EXPECT_TRUE(u * diagonalMatrix(s) * v.Transpose() == m);
+  EXPECT_TRUE(u.Transpose() * u == identityMatrix(37));
+  EXPECT_TRUE(v.Transpose() * v == identityMatrix(37));
+  for (int i = 1; i < 37; i++) EXPECT_GE(s(i - 1, 0), s(i, 0));
+  EXPECT_EQ(svd.Rank(), 37);
+  EXPECT_NEAR(svd.ConditionNumber(), s(0, 0) / s(36, 0), 1e-9);
+}
+
+TEST(test, svd_2) {
+  S21Matrix m = S21Matrix(3, 5);
+  fillMatrixWithStep(m, 1);
+  S21SVD svd(m);
+  S21Matrix s = svd.GetSingularValues();
+  EXPECT_EQ(svd.GetU().GetRows(), 3);
+  EXPECT_EQ(svd.GetV().GetRows(), 5);
+  EXPECT_TRUE(svd.GetU() * diagonalMatrix(s) * svd.GetV().Transpose() == m);
+  EXPECT_EQ(svd.Rank(), 2);
+  EXPECT_GT(svd.ConditionNumber(), 1e12);
+  S21Matrix zero = S21Matrix(2, 2);
+  EXPECT_EQ(S21SVD(zero).Rank(), 0);
+  EXPECT_EQ(S21SVD(zero).ConditionNumber(), INFINITY);
+  EXPECT_THROW(S21SVD{S21Matrix()}, std::logic_error);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();